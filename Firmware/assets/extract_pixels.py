@@ -1,6 +1,7 @@
-import cv2
-
+import sys
 
+# 指针使用的颜色, 渲染时替换为用户设置的指针颜色
+POINTER_COLORS = [0xff1414, 0xcb1a1a, 0xbe1515]
 
 mask = [
     [0,0,1,1,1,1,1,1,1,1,],
@@ -10,38 +11,83 @@ mask = [
     [0,0,1,1,1,1,1,1,0,0,],
     ]
 
-frames = []
-
-for img_id in range(1,29):
-    path = "./assets/compass{}.bmp".format(img_id)
-    img = cv2.imread(path)
-    x = 0
-    y = 2
-    colors = []
-    while x < 10:
-        if mask[y][x] == 1:
-            colors.append(img[y][x])
-        if x % 2 == 0:
-            y -= 1
-        else:
-            y += 1
-        if y < 0 or y > 4:
-            x += 1
+
+def load_frames():
+    import cv2
+
+    frames = []
+    for img_id in range(1,29):
+        path = "./assets/compass{}.bmp".format(img_id)
+        img = cv2.imread(path)
+        x = 0
+        y = 2
+        colors = []
+        while x < 10:
+            if mask[y][x] == 1:
+                g,b,r = img[y][x]
+                colors.append(int(r) << 16 | int(g) << 8 | int(b))
             if x % 2 == 0:
-                y = 4
+                y -= 1
             else:
-                y = 0
-    frames.append(colors)
-
-print("#pragma once")
-print("#include <stdint.h>")
-print("uint32_t frames[{0}][{1}] = ".format(len(frames), len(frames[0])))
-print("{")
-for frame in frames:
-    print("{")
-    for color in frame:
-        g,b,r = color
-        rgb = r << 16 | g << 8 | b
-        print("{},".format(hex(rgb)))
-    print("},")
-print("};")
\ No newline at end of file
+                y += 1
+            if y < 0 or y > 4:
+                x += 1
+                if x % 2 == 0:
+                    y = 4
+                else:
+                    y = 0
+        frames.append(colors)
+    return frames
+
+
+def build_palette(frames):
+    # 黑色固定在0号, 其余按出现次数排序
+    counts = {}
+    for frame in frames:
+        for color in frame:
+            counts[color] = counts.get(color, 0) + 1
+    palette = [0] + sorted((c for c in counts if c != 0),
+                           key=lambda c: (-counts[c], c))
+    if len(palette) > 16:
+        sys.exit("too many colors for 4-bit frames: {}".format(len(palette)))
+    return palette
+
+
+def emit(frames, out=sys.stdout):
+    palette = build_palette(frames)
+    pixels = len(frames[0])
+
+    def p(line=""):
+        out.write(line + "\n")
+
+    p("#pragma once")
+    p("#include <stdint.h>")
+    p("// 由 assets/extract_pixels.py 生成, 常量数据保存在flash中")
+    p("")
+    p("/// 调色板, 0号为黑色")
+    p("const uint32_t framePalette[{}] = {{".format(len(palette)))
+    p("    " + ", ".join("0x{:06x}".format(c) for c in palette) + ",")
+    p("};")
+    p("")
+    p("/// 每帧{}个像素, 每像素4位调色板索引, 低4位在前".format(pixels))
+    p("const uint8_t frames[{}][{}] = {{".format(len(frames), (pixels + 1) // 2))
+    for frame in frames:
+        indices = [palette.index(c) for c in frame] + [0]
+        packed = [indices[i] | indices[i + 1] << 4
+                  for i in range(0, pixels, 2)]
+        p("    {" + ", ".join("0x{:02x}".format(b) for b in packed) + "},")
+    p("};")
+    p("")
+    p("/// 每帧的指针像素掩码, 第i位对应第i个像素, 渲染时替换为指针颜色")
+    p("const uint64_t framePointerMasks[{}] = {{".format(len(frames)))
+    for frame in frames:
+        bits = 0
+        for i, color in enumerate(frame):
+            if color in POINTER_COLORS:
+                bits |= 1 << i
+        p("    0x{:011x}ULL,".format(bits))
+    p("};")
+
+
+if __name__ == "__main__":
+    emit(load_frames())
@@ -0,0 +1,205 @@
+// bench_main.cpp
+// 方位角到LED渲染路径的微基准测试.
+// 结果以 JSON 输出到 stdout, 便于脚本比较回归; 可读的表格输出到 stderr.
+//
+//   mcompass_bench [iterations]
+//
+// 定点 atan2 的误差超过0.1度时返回1.
+#include <FastLED.h>
+#include <chrono>
+#include <esp_cpu.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "board.h"
+#include "context.h"
+
+using namespace mcompass;
+
+namespace {
+
+struct Result {
+  const char *name;
+  double nsPerCall;
+  double cyclesPerCall;
+};
+
+volatile double g_sink = 0;
+
+/**
+ * @brief 重复运行 runs 轮, 每轮调用 fn(i) iterations 次, 取最快一轮的单次耗时
+ */
+template <typename Fn>
+Result measure(const char *name, int iterations, Fn fn) {
+  const int runs = 5;
+  // 预热
+  for (int i = 0; i < iterations / 10; i++) {
+    fn(i);
+  }
+  double bestNs = 0;
+  double bestCycles = 0;
+  for (int r = 0; r < runs; r++) {
+    auto start = std::chrono::steady_clock::now();
+    esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+    for (int i = 0; i < iterations; i++) {
+      fn(i);
+    }
+    esp_cpu_cycle_count_t cycles = esp_cpu_get_cycle_count() - startCycles;
+    auto end = std::chrono::steady_clock::now();
+    double ns =
+        std::chrono::duration<double, std::nano>(end - start).count() /
+        iterations;
+    if (r == 0 || ns < bestNs) {
+      bestNs = ns;
+      bestCycles = double(cycles) / iterations;
+    }
+  }
+  return {name, bestNs, bestCycles};
+}
+
+const Result &find(const std::vector<Result> &results, const char *name) {
+  for (const Result &result : results) {
+    if (strcmp(result.name, name) == 0) {
+      return result;
+    }
+  }
+  abort();
+}
+
+/// 相减得到的耗时可能因测量噪声为负, 截断到0
+double positive(double value) { return value > 0 ? value : 0; }
+
+/**
+ * @brief atan2Centideg 与双精度 atan2 的最大误差(度), 覆盖整圈和不同幅值
+ */
+double atan2MaxErrorDeg() {
+  double maxError = 0;
+  const double magnitudes[] = {3, 40, 1500, 32767, 1e6, 4e12};
+  for (double magnitude : magnitudes) {
+    for (int i = 0; i < 36000; i++) {
+      double rad = i * M_PI / 18000.0 + 1e-3;
+      int64_t x = llround(magnitude * cos(rad));
+      int64_t y = llround(magnitude * sin(rad));
+      if (x == 0 && y == 0) {
+        continue;
+      }
+      double expected = atan2((double)y, (double)x) * 18000.0 / M_PI;
+      double error = fabs(fixed::atan2Centideg(y, x) - expected);
+      if (error > 18000.0) {
+        error = 36000.0 - error;
+      }
+      maxError = std::max(maxError, error / 100.0);
+    }
+  }
+  return maxError;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+  if (iterations <= 0) {
+    iterations = 200000;
+  }
+
+  Context &context = Context::getInstance();
+  preference::init(&context);
+  pixel::init(&context);
+
+  // 出生点与当前位置, 相距约1km
+  const float spawnLat = 39.908692f, spawnLon = 116.397477f;
+  const float currentLat = 39.915f, currentLon = 116.404f;
+
+  std::vector<Result> results;
+  results.push_back(measure("spring_float", iterations, [](int i) {
+    g_sink = mathbench::springFloat((i * 7) % 360);
+  }));
+  results.push_back(measure("spring_update", iterations, [](int i) {
+    // 帧间隔在 16/17 毫秒之间交替, 与60Hz渲染一致
+    g_sink = spring::update((i * 701) % angle::FULL_TURN, 16667);
+  }));
+  results.push_back(measure("heading_float", iterations, [](int i) {
+    g_sink = mathbench::headingFloat(1200 - (i % 2400), (i * 37) % 2400 - 1200);
+  }));
+  results.push_back(measure("heading_fixed", iterations, [](int i) {
+    g_sink = mathbench::headingFixed(1200 - (i % 2400), (i * 37) % 2400 - 1200);
+  }));
+  results.push_back(measure("calculate_bearing", iterations, [&](int i) {
+    g_sink = utils::calculateBearing(currentLat, currentLon,
+                                     spawnLat + (i % 16) * 1e-4, spawnLon);
+  }));
+  results.push_back(measure("context_snapshot", iterations, [&](int) {
+    ContextSnapshot snap = context.snapshot();
+    g_sink = snap.currentLocation.latitude + snap.brightness;
+  }));
+  results.push_back(measure("led_show", iterations, [](int) {
+    FastLED.show();
+  }));
+  results.push_back(measure("show_frame", iterations, [](int i) {
+    pixel::showFrame(i % (MAX_FRAME_INDEX + 1));
+  }));
+  results.push_back(measure("show_by_azimuth", iterations, [](int i) {
+    pixel::showByAzimuth((i * 701) % angle::FULL_TURN);
+  }));
+  results.push_back(measure("show_frame_by_location", iterations, [&](int i) {
+    pixel::showFrameByLocation(spawnLat, spawnLon, currentLat, currentLon,
+                               (i * 701) % angle::FULL_TURN);
+  }));
+
+  // 拆分: LED输出 = FastLED.show(), 帧拷贝 = showFrame - show,
+  // 数学运算 = 上层函数 - showFrame
+  const Result &ledShow = find(results, "led_show");
+  const Result &showFrame = find(results, "show_frame");
+  double frameCopyNs = positive(showFrame.nsPerCall - ledShow.nsPerCall);
+  double frameCopyCycles =
+      positive(showFrame.cyclesPerCall - ledShow.cyclesPerCall);
+  const char *splitNames[] = {"show_by_azimuth", "show_frame_by_location"};
+
+  // 定点 atan2 的精度要求: 误差小于0.1度
+  double atan2Error = atan2MaxErrorDeg();
+
+  printf("{\n");
+  printf("  \"iterations\": %d,\n", iterations);
+  printf("  \"atan2_max_error_deg\": %.4f,\n", atan2Error);
+  // 与设备上 /mathBench 相同的对照, 主机有FPU, 只有设备上的数字反映定点化的收益
+  char mathJson[128];
+  printf("  \"math_cycles\": %s,\n",
+         mathbench::toJson(mathJson, sizeof(mathJson), iterations) ? mathJson
+                                                                  : "null");
+  printf("  \"led_wire_time_ns\": %lld,\n",
+         (long long)host::ledTransmitTimeUs(NUM_LEDS) * 1000);
+  printf("  \"results\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    printf("    {\"name\": \"%s\", \"ns_per_call\": %.2f, "
+           "\"cycles_per_call\": %.1f}%s\n",
+           results[i].name, results[i].nsPerCall, results[i].cyclesPerCall,
+           i + 1 < results.size() ? "," : "");
+  }
+  printf("  ],\n");
+  printf("  \"split\": [\n");
+  for (size_t i = 0; i < 2; i++) {
+    const Result &total = find(results, splitNames[i]);
+    printf("    {\"name\": \"%s\", \"math_ns\": %.2f, \"frame_copy_ns\": %.2f, "
+           "\"led_output_ns\": %.2f, \"math_cycles\": %.1f, "
+           "\"frame_copy_cycles\": %.1f, \"led_output_cycles\": %.1f}%s\n",
+           total.name, positive(total.nsPerCall - showFrame.nsPerCall),
+           frameCopyNs, ledShow.nsPerCall,
+           positive(total.cyclesPerCall - showFrame.cyclesPerCall),
+           frameCopyCycles, ledShow.cyclesPerCall, i == 0 ? "," : "");
+  }
+  printf("  ]\n");
+  printf("}\n");
+
+  fprintf(stderr, "%-24s %12s %14s\n", "benchmark", "ns/call", "cycles/call");
+  for (const Result &result : results) {
+    fprintf(stderr, "%-24s %12.2f %14.1f\n", result.name, result.nsPerCall,
+            result.cyclesPerCall);
+  }
+  fprintf(stderr,
+          "led output on device adds ~%lld us of WS2812 wire time per frame\n",
+          (long long)host::ledTransmitTimeUs(NUM_LEDS));
+  fprintf(stderr, "atan2 max error %.4f deg\n", atan2Error);
+  return atan2Error < 0.1 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// Arduino.cpp (host)
+#include "Arduino.h"
+
+#include <map>
+#include <random>
+#include <stdarg.h>
+
+#include "host_hal.h"
+#include "soc/usb_serial_jtag_reg.h"
+
+HostSerial Serial;
+
+uint32_t host_usb_serial_jtag_fram_num = 0;
+
+static std::mt19937 s_random(0x4d43); // 固定种子, 保证回放可复现
+static std::map<uint8_t, int> s_pinLevels;
+
+unsigned long millis() { return host::now() / 1000; }
+
+unsigned long micros() { return host::now(); }
+
+void delay(uint32_t ms) { host::advance(int64_t(ms) * 1000); }
+
+void delayMicroseconds(uint32_t us) { host::advance(us); }
+
+long random(long howbig) {
+  if (howbig <= 0) {
+    return 0;
+  }
+  return std::uniform_int_distribution<long>(0, howbig - 1)(s_random);
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) {
+    return howsmall;
+  }
+  return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) { s_random.seed(seed); }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  // 上拉输入默认读到高电平
+  if (mode == INPUT_PULLUP && s_pinLevels.find(pin) == s_pinLevels.end()) {
+    s_pinLevels[pin] = HIGH;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) { s_pinLevels[pin] = val; }
+
+int digitalRead(uint8_t pin) { return host::pinLevel(pin); }
+
+void host::setPinLevel(uint8_t pin, int level) { s_pinLevels[pin] = level; }
+
+int host::pinLevel(uint8_t pin) {
+  auto it = s_pinLevels.find(pin);
+  return it == s_pinLevels.end() ? LOW : it->second;
+}
+
+static std::string formatInteger(unsigned long long value, bool negative,
+                                 unsigned char base) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+  std::string digits;
+  do {
+    int digit = value % base;
+    digits.insert(digits.begin(), digit < 10 ? '0' + digit : 'a' + digit - 10);
+    value /= base;
+  } while (value);
+  if (negative) {
+    digits.insert(digits.begin(), '-');
+  }
+  return digits;
+}
+
+String::String(int value, unsigned char base) : String(long(value), base) {}
+
+String::String(unsigned int value, unsigned char base)
+    : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base)
+    : _buffer(formatInteger(value < 0 && base == 10
+                                ? 0ULL - (unsigned long long)value
+                                : (unsigned long long)value,
+                            value < 0 && base == 10, base)) {}
+
+String::String(unsigned long value, unsigned char base)
+    : _buffer(formatInteger(value, false, base)) {}
+
+String::String(float value, unsigned int decimalPlaces)
+    : String(double(value), decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  _buffer = buf;
+}
+
+size_t HostSerial::printf(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int n = vprintf(format, args);
+  va_end(args);
+  return n < 0 ? 0 : n;
+}
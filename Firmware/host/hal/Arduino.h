@@ -0,0 +1,155 @@
+// Arduino.h (host)
+// 主机构建用的 Arduino 核心替身, 只实现固件实际用到的部分
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <string>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#ifndef F_CPU
+#define F_CPU 160000000L
+#endif
+
+#define DEC 10
+#define HEX 16
+
+/// 虚拟时钟, 由 esp_timer_get_time 驱动
+unsigned long millis();
+unsigned long micros();
+/// 推进虚拟时钟, 期间到期的 esp_timer 会被触发
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+/// 伪随机数, 主机上使用固定种子保证可复现
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+/// 精简版 Arduino String, 内部使用 std::string
+class String {
+public:
+  String() = default;
+  String(const char *cstr) : _buffer(cstr ? cstr : "") {}
+  String(const std::string &str) : _buffer(str) {}
+  String(char c) : _buffer(1, c) {}
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned int decimalPlaces = 2);
+  explicit String(double value, unsigned int decimalPlaces = 2);
+
+  unsigned int length() const { return _buffer.length(); }
+  const char *c_str() const { return _buffer.c_str(); }
+  char charAt(unsigned int index) const {
+    return index < _buffer.length() ? _buffer[index] : 0;
+  }
+  char operator[](unsigned int index) const { return charAt(index); }
+  long toInt() const { return strtol(_buffer.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_buffer.c_str(), nullptr); }
+  bool isEmpty() const { return _buffer.empty(); }
+
+  String &operator+=(const String &rhs) {
+    _buffer += rhs._buffer;
+    return *this;
+  }
+  String &operator+=(const char *rhs) {
+    _buffer += rhs;
+    return *this;
+  }
+  String &operator+=(char c) {
+    _buffer += c;
+    return *this;
+  }
+
+  friend String operator+(const String &lhs, const String &rhs) {
+    return String(lhs._buffer + rhs._buffer);
+  }
+  friend String operator+(const String &lhs, const char *rhs) {
+    return String(lhs._buffer + rhs);
+  }
+  friend String operator+(const char *lhs, const String &rhs) {
+    return String(lhs + rhs._buffer);
+  }
+  bool operator==(const String &rhs) const { return _buffer == rhs._buffer; }
+  bool operator==(const char *rhs) const { return _buffer == rhs; }
+  bool operator!=(const String &rhs) const { return _buffer != rhs._buffer; }
+
+private:
+  std::string _buffer;
+};
+
+/// 串口替身, 输出到 stdout
+class HostSerial {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void flush() { fflush(stdout); }
+  size_t print(const char *str) { return fputs(str, stdout) >= 0 ? 1 : 0; }
+  size_t print(const String &str) { return print(str.c_str()); }
+  size_t print(char c) { return fputc(c, stdout) != EOF ? 1 : 0; }
+  size_t print(int value, int base = DEC) { return print((long)value, base); }
+  size_t print(unsigned int value, int base = DEC) {
+    return print((unsigned long)value, base);
+  }
+  size_t print(long value, int base = DEC) {
+    return base == HEX ? ::printf("%lX", value) : ::printf("%ld", value);
+  }
+  size_t print(unsigned long value, int base = DEC) {
+    return base == HEX ? ::printf("%lX", value) : ::printf("%lu", value);
+  }
+  size_t print(unsigned char value, int base = DEC) {
+    return print((unsigned long)value, base);
+  }
+  size_t print(double value, int digits = 2) {
+    return ::printf("%.*f", digits, value);
+  }
+  template <typename T> size_t println(T value) {
+    size_t n = print(value);
+    return n + print("\r\n");
+  }
+  template <typename T> size_t println(T value, int format) {
+    size_t n = print(value, format);
+    return n + print("\r\n");
+  }
+  size_t println() { return print("\r\n"); }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HostSerial Serial;
+#endif // __cplusplus
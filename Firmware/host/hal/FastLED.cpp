@@ -0,0 +1,39 @@
+// FastLED.cpp (host)
+#include "FastLED.h"
+
+#include <vector>
+
+#include "host_hal.h"
+
+CFastLED FastLED;
+
+static uint32_t s_showCount = 0;
+static std::vector<CRGB> s_frame;
+static uint8_t s_brightness = 0;
+
+/// WS2812 每颗灯 24 位, 每位 1.25us, 另加 50us 复位时间
+int64_t host::ledTransmitTimeUs(int numLeds) { return numLeds * 30 + 50; }
+
+void CFastLED::show() { show(_brightness); }
+
+void CFastLED::show(uint8_t scale) {
+  s_frame.assign(_leds, _leds + _numLeds);
+  s_brightness = scale;
+  s_showCount++;
+  host::advance(host::ledTransmitTimeUs(_numLeds));
+}
+
+void CFastLED::clear(bool writeData) {
+  if (_leds) {
+    fill_solid(_leds, _numLeds, CRGB::Black);
+  }
+  if (writeData) {
+    show();
+  }
+}
+
+uint32_t host::ledShowCount() { return s_showCount; }
+
+const CRGB *host::ledFrame() { return s_frame.data(); }
+
+uint8_t host::ledBrightness() { return s_brightness; }
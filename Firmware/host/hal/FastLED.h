@@ -0,0 +1,107 @@
+// FastLED.h (host)
+// FastLED替身: 只保留固件用到的 CRGB 与 CFastLED 接口, show() 不驱动任何硬件,
+// 而是记录一次发送并按 WS2812 时序推进虚拟时钟
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+struct CRGB {
+  uint8_t r = 0;
+  uint8_t g = 0;
+  uint8_t b = 0;
+
+  enum HTMLColorCode : uint32_t {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Green = 0x008000,
+    Red = 0xFF0000,
+    White = 0xFFFFFF,
+  };
+
+  CRGB() = default;
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t colorcode)
+      : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF),
+        b(colorcode & 0xFF) {}
+  CRGB(HTMLColorCode colorcode) : CRGB(static_cast<uint32_t>(colorcode)) {}
+
+  CRGB &operator=(uint32_t colorcode) {
+    r = (colorcode >> 16) & 0xFF;
+    g = (colorcode >> 8) & 0xFF;
+    b = colorcode & 0xFF;
+    return *this;
+  }
+
+  CRGB &nscale8(uint8_t scaledown) {
+    r = (uint16_t(r) * (1 + scaledown)) >> 8;
+    g = (uint16_t(g) * (1 + scaledown)) >> 8;
+    b = (uint16_t(b) * (1 + scaledown)) >> 8;
+    return *this;
+  }
+  CRGB &fadeToBlackBy(uint8_t fadefactor) { return nscale8(255 - fadefactor); }
+
+  bool operator==(const CRGB &rhs) const {
+    return r == rhs.r && g == rhs.g && b == rhs.b;
+  }
+  bool operator!=(const CRGB &rhs) const { return !(*this == rhs); }
+};
+
+inline void fill_solid(CRGB *leds, int numToFill, const CRGB &color) {
+  for (int i = 0; i < numToFill; i++) {
+    leds[i] = color;
+  }
+}
+
+template <uint8_t DATA_PIN> class NEOPIXEL {};
+
+class CFastLED {
+public:
+  template <template <uint8_t DATA_PIN> class CHIPSET, uint8_t DATA_PIN>
+  CFastLED &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+    _leds = data + (nLedsIfOffset > 0 ? nLedsOrOffset : 0);
+    _numLeds = nLedsIfOffset > 0 ? nLedsIfOffset : nLedsOrOffset;
+    return *this;
+  }
+
+  void setBrightness(uint8_t scale) { _brightness = scale; }
+  uint8_t getBrightness() const { return _brightness; }
+
+  void show();
+  void show(uint8_t scale);
+  void clear(bool writeData = false);
+
+  CRGB *leds() { return _leds; }
+  int size() const { return _numLeds; }
+
+private:
+  CRGB *_leds = nullptr;
+  int _numLeds = 0;
+  uint8_t _brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+namespace host {
+
+/**
+ * @brief 累计调用 FastLED.show() 的次数
+ */
+uint32_t ledShowCount();
+
+/**
+ * @brief 最近一次发送到灯带的数据(未应用亮度)
+ */
+const CRGB *ledFrame();
+
+/**
+ * @brief 最近一次发送时的亮度
+ */
+uint8_t ledBrightness();
+
+/**
+ * @brief 按 WS2812 时序估算发送 numLeds 颗灯数据所需的时间(微秒)
+ */
+int64_t ledTransmitTimeUs(int numLeds);
+
+} // namespace host
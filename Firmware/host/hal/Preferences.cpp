@@ -0,0 +1,153 @@
+// Preferences.cpp (host)
+#include "Preferences.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+
+static std::map<std::string, Namespace> &storage() {
+  static std::map<std::string, Namespace> s_storage;
+  return s_storage;
+}
+
+bool Preferences::begin(const char *name, bool readOnly,
+                        const char *partition_label) {
+  (void)partition_label;
+  if (!name) {
+    return false;
+  }
+  _namespace = name;
+  _readOnly = readOnly;
+  storage()[_namespace];
+  return true;
+}
+
+void Preferences::end() { _namespace = nullptr; }
+
+bool Preferences::clear() {
+  if (!_namespace || _readOnly) {
+    return false;
+  }
+  storage()[_namespace].clear();
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  if (!_namespace || _readOnly || !key) {
+    return false;
+  }
+  return storage()[_namespace].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  if (!_namespace || !key) {
+    return false;
+  }
+  Namespace &ns = storage()[_namespace];
+  return ns.find(key) != ns.end();
+}
+
+size_t Preferences::_put(const char *key, const void *value, size_t len) {
+  if (!_namespace || _readOnly || !key) {
+    return 0;
+  }
+  auto *bytes = static_cast<const uint8_t *>(value);
+  storage()[_namespace][key].assign(bytes, bytes + len);
+  return len;
+}
+
+size_t Preferences::_get(const char *key, void *buf, size_t len) {
+  if (!_namespace || !key) {
+    return 0;
+  }
+  Namespace &ns = storage()[_namespace];
+  auto it = ns.find(key);
+  if (it == ns.end() || it->second.size() != len) {
+    return 0;
+  }
+  memcpy(buf, it->second.data(), len);
+  return len;
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value) {
+  return _put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putInt(const char *key, int32_t value) {
+  return _put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+  return _put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putBool(const char *key, bool value) {
+  return putUChar(key, value ? 1 : 0);
+}
+
+size_t Preferences::putFloat(const char *key, float value) {
+  return _put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char *key, const String &value) {
+  // 与NVS一致, 字符串带结尾的 '\0'
+  return _put(key, value.c_str(), value.length() + 1);
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+  return _put(key, value, len);
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue) {
+  uint8_t value = defaultValue;
+  _get(key, &value, sizeof(value));
+  return value;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t defaultValue) {
+  int32_t value = defaultValue;
+  _get(key, &value, sizeof(value));
+  return value;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) {
+  uint32_t value = defaultValue;
+  _get(key, &value, sizeof(value));
+  return value;
+}
+
+bool Preferences::getBool(const char *key, bool defaultValue) {
+  return getUChar(key, defaultValue ? 1 : 0) == 1;
+}
+
+float Preferences::getFloat(const char *key, float defaultValue) {
+  float value = defaultValue;
+  _get(key, &value, sizeof(value));
+  return value;
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+  if (!isKey(key)) {
+    return defaultValue;
+  }
+  const std::vector<uint8_t> &bytes = storage()[_namespace][key];
+  return String(std::string(bytes.begin(), bytes.end()).c_str());
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  if (!isKey(key)) {
+    return 0;
+  }
+  return storage()[_namespace][key].size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  size_t len = getBytesLength(key);
+  if (!len || !buf || len > maxLen) {
+    return 0;
+  }
+  memcpy(buf, storage()[_namespace][key].data(), len);
+  return len;
+}
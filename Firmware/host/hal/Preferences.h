@@ -0,0 +1,43 @@
+// Preferences.h (host)
+// NVS替身, 数据保存在进程内存中, 进程退出即丢失
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Arduino.h"
+
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly = false,
+             const char *partition_label = nullptr);
+  void end();
+
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+
+  size_t putUChar(const char *key, uint8_t value);
+  size_t putInt(const char *key, int32_t value);
+  size_t putUInt(const char *key, uint32_t value);
+  size_t putBool(const char *key, bool value);
+  size_t putFloat(const char *key, float value);
+  size_t putString(const char *key, const String &value);
+  size_t putBytes(const char *key, const void *value, size_t len);
+
+  uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+  int32_t getInt(const char *key, int32_t defaultValue = 0);
+  uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+  bool getBool(const char *key, bool defaultValue = false);
+  float getFloat(const char *key, float defaultValue = NAN);
+  String getString(const char *key, const String &defaultValue = String());
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+private:
+  size_t _put(const char *key, const void *value, size_t len);
+  size_t _get(const char *key, void *buf, size_t len);
+
+  const char *_namespace = nullptr;
+  bool _readOnly = false;
+};
@@ -0,0 +1,191 @@
+// Wire.cpp (host)
+#include "Wire.h"
+
+#include <map>
+
+#include "driver/i2c.h"
+#include "host_hal.h"
+
+TwoWire Wire;
+
+static std::map<uint8_t, host::I2CDevice *> s_devices;
+static std::map<uint8_t, uint8_t> s_registerPointers;
+static int64_t s_busTimeUs = 0;
+
+void host::attachI2CDevice(uint8_t address, I2CDevice *device) {
+  s_devices[address] = device;
+  s_registerPointers[address] = 0;
+}
+
+void host::detachI2CDevice(uint8_t address) {
+  s_devices.erase(address);
+  s_registerPointers.erase(address);
+}
+
+int64_t host::i2cBusTimeUs() { return s_busTimeUs; }
+
+/// 每字节 8 位数据 + 1 位应答, 另加起始/停止与地址字节
+static void chargeBus(uint32_t clock, size_t bytes) {
+  int64_t bits = int64_t(bytes + 1) * 9 + 2;
+  int64_t us = (bits * 1000000 + clock - 1) / clock;
+  s_busTimeUs += us;
+  host::advance(us);
+}
+
+int64_t host::i2cTransferTimeUs(uint32_t clock, size_t txLength,
+                                size_t rxLength) {
+  // 写段与读段各自带一个地址字节, 读段前为重复起始
+  int64_t bits = int64_t(txLength + 1) * 9 + 2;
+  if (rxLength > 0) {
+    bits += int64_t(rxLength + 1) * 9 + 1;
+  }
+  return (bits * 1000000 + clock - 1) / clock;
+}
+
+bool host::i2cTransfer(uint8_t address, const uint8_t *tx, size_t txLength,
+                       uint8_t *rx, size_t rxLength, uint32_t clock) {
+  s_busTimeUs += i2cTransferTimeUs(clock, txLength, rxLength);
+  auto it = s_devices.find(address);
+  if (it == s_devices.end()) {
+    return false;
+  }
+  if (txLength > 0) {
+    uint8_t reg = tx[0];
+    for (size_t i = 1; i < txLength; i++) {
+      it->second->writeRegister(reg++, tx[i]);
+    }
+    s_registerPointers[address] = tx[0];
+  }
+  uint8_t &reg = s_registerPointers[address];
+  for (size_t i = 0; i < rxLength; i++) {
+    rx[i] = it->second->readRegister(reg++);
+  }
+  return true;
+}
+
+/// driver/i2c.h: 同步完成, 推进虚拟时钟
+static esp_err_t transferBlocking(uint8_t address, const uint8_t *tx,
+                                  size_t txLength, uint8_t *rx,
+                                  size_t rxLength) {
+  int64_t before = s_busTimeUs;
+  bool ok =
+      host::i2cTransfer(address, tx, txLength, rx, rxLength, Wire.getClock());
+  host::advance(s_busTimeUs - before);
+  return ok ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t i2c_master_write_to_device(i2c_port_t i2c_num, uint8_t device_address,
+                                     const uint8_t *write_buffer,
+                                     size_t write_size,
+                                     TickType_t ticks_to_wait) {
+  (void)i2c_num;
+  (void)ticks_to_wait;
+  return transferBlocking(device_address, write_buffer, write_size, nullptr,
+                          0);
+}
+
+esp_err_t i2c_master_write_read_device(i2c_port_t i2c_num,
+                                       uint8_t device_address,
+                                       const uint8_t *write_buffer,
+                                       size_t write_size,
+                                       uint8_t *read_buffer, size_t read_size,
+                                       TickType_t ticks_to_wait) {
+  (void)i2c_num;
+  (void)ticks_to_wait;
+  return transferBlocking(device_address, write_buffer, write_size,
+                          read_buffer, read_size);
+}
+
+bool TwoWire::begin() { return true; }
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+  (void)sda;
+  (void)scl;
+  if (frequency) {
+    _clock = frequency;
+  }
+  return true;
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+  if (frequency) {
+    _clock = frequency;
+  }
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  _txAddress = address;
+  _txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (_txLength >= sizeof(_txBuffer)) {
+    return 0;
+  }
+  _txBuffer[_txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t written = 0;
+  while (written < quantity && write(data[written])) {
+    written++;
+  }
+  return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  (void)sendStop;
+  chargeBus(_clock, _txLength);
+  auto it = s_devices.find(_txAddress);
+  if (it == s_devices.end()) {
+    // 地址无应答
+    return 2;
+  }
+  if (_txLength > 0) {
+    // 第一个字节是寄存器地址, 后续字节依次写入
+    uint8_t reg = _txBuffer[0];
+    for (size_t i = 1; i < _txLength; i++) {
+      it->second->writeRegister(reg++, _txBuffer[i]);
+    }
+    s_registerPointers[_txAddress] = _txBuffer[0];
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity,
+                             bool sendStop) {
+  (void)sendStop;
+  _rxLength = 0;
+  _rxIndex = 0;
+  if (quantity > sizeof(_rxBuffer)) {
+    quantity = sizeof(_rxBuffer);
+  }
+  chargeBus(_clock, quantity);
+  auto it = s_devices.find(address);
+  if (it == s_devices.end()) {
+    return 0;
+  }
+  uint8_t &reg = s_registerPointers[address];
+  for (uint8_t i = 0; i < quantity; i++) {
+    _rxBuffer[_rxLength++] = it->second->readRegister(reg++);
+  }
+  return quantity;
+}
+
+int TwoWire::available() { return _rxLength - _rxIndex; }
+
+int TwoWire::read() {
+  if (_rxIndex >= _rxLength) {
+    return -1;
+  }
+  return _rxBuffer[_rxIndex++];
+}
+
+size_t TwoWire::readBytes(uint8_t *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length && _rxIndex < _rxLength) {
+    buffer[count++] = _rxBuffer[_rxIndex++];
+  }
+  return count;
+}
@@ -0,0 +1,51 @@
+// Wire.h (host)
+// I2C主机替身, 事务被转发给 host::attachI2CDevice 挂载的模拟设备,
+// 每次传输按总线时钟推进虚拟时钟
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class TwoWire {
+public:
+  bool begin();
+  bool begin(int sda, int scl, uint32_t frequency = 0);
+  void setClock(uint32_t frequency);
+  uint32_t getClock() const { return _clock; }
+  // 主机上传输同步完成, 超时只记录不生效
+  void setTimeOut(uint16_t timeOutMillis) { _timeOut = timeOutMillis; }
+  uint16_t getTimeOut() const { return _timeOut; }
+
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) {
+    beginTransmission(static_cast<uint8_t>(address));
+  }
+  size_t write(uint8_t data);
+  size_t write(const uint8_t *data, size_t quantity);
+  uint8_t endTransmission(bool sendStop = true);
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity,
+                      bool sendStop = true);
+  uint8_t requestFrom(int address, int quantity) {
+    return requestFrom(static_cast<uint8_t>(address),
+                       static_cast<uint8_t>(quantity));
+  }
+  int available();
+  int read();
+  size_t readBytes(uint8_t *buffer, size_t length);
+  size_t readBytes(char *buffer, size_t length) {
+    return readBytes(reinterpret_cast<uint8_t *>(buffer), length);
+  }
+
+private:
+  uint32_t _clock = 100000;
+  uint16_t _timeOut = 50;
+  uint8_t _txAddress = 0;
+  uint8_t _txBuffer[32];
+  size_t _txLength = 0;
+  uint8_t _rxBuffer[32];
+  size_t _rxLength = 0;
+  size_t _rxIndex = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,34 @@
+// driver/i2c.h (host)
+// 只提供 AsyncI2CTransport 用到的主机读写函数, 与 Wire 一样转发给模拟设备,
+// 同步完成并按总线时钟推进虚拟时钟
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0 0
+
+esp_err_t i2c_master_write_to_device(i2c_port_t i2c_num, uint8_t device_address,
+                                     const uint8_t *write_buffer,
+                                     size_t write_size,
+                                     TickType_t ticks_to_wait);
+
+esp_err_t i2c_master_write_read_device(i2c_port_t i2c_num,
+                                       uint8_t device_address,
+                                       const uint8_t *write_buffer,
+                                       size_t write_size,
+                                       uint8_t *read_buffer, size_t read_size,
+                                       TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
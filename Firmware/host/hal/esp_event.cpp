@@ -0,0 +1,200 @@
+// esp_event.cpp (host)
+#include "esp_event.h"
+
+#include <deque>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+struct Handler {
+  esp_event_base_t base;
+  int32_t id;
+  esp_event_handler_t handler;
+  void *arg;
+  bool removed;
+};
+
+struct PendingEvent {
+  esp_event_base_t base;
+  int32_t id;
+  std::vector<uint8_t> data;
+};
+
+struct EventLoop {
+  size_t queueSize;
+  std::deque<PendingEvent> queue;
+  std::vector<Handler> handlers;
+  int dispatchDepth;
+};
+
+EventLoop *s_defaultLoop = nullptr;
+
+bool matches(const Handler &h, esp_event_base_t base, int32_t id) {
+  if (h.removed) {
+    return false;
+  }
+  bool baseMatch = h.base == ESP_EVENT_ANY_BASE || h.base == base ||
+                   (h.base && base && strcmp(h.base, base) == 0);
+  bool idMatch = h.id == ESP_EVENT_ANY_ID || h.id == id;
+  return baseMatch && idMatch;
+}
+
+} // namespace
+
+esp_err_t esp_event_loop_create(const esp_event_loop_args_t *event_loop_args,
+                                esp_event_loop_handle_t *event_loop) {
+  if (event_loop_args == nullptr || event_loop == nullptr ||
+      event_loop_args->queue_size <= 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *loop = new EventLoop();
+  loop->queueSize = event_loop_args->queue_size;
+  loop->dispatchDepth = 0;
+  *event_loop = loop;
+  return ESP_OK;
+}
+
+esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop) {
+  if (event_loop == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *loop = static_cast<EventLoop *>(event_loop);
+  if (loop == s_defaultLoop) {
+    s_defaultLoop = nullptr;
+  }
+  delete loop;
+  return ESP_OK;
+}
+
+esp_err_t esp_event_loop_create_default(void) {
+  if (s_defaultLoop != nullptr) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  esp_event_loop_args_t args = {.queue_size = 32, .task_name = "sys_evt"};
+  esp_event_loop_handle_t handle;
+  esp_err_t err = esp_event_loop_create(&args, &handle);
+  if (err == ESP_OK) {
+    s_defaultLoop = static_cast<EventLoop *>(handle);
+  }
+  return err;
+}
+
+esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop,
+                             TickType_t ticks_to_run) {
+  (void)ticks_to_run;
+  if (event_loop == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *loop = static_cast<EventLoop *>(event_loop);
+  loop->dispatchDepth++;
+  while (!loop->queue.empty()) {
+    PendingEvent event = std::move(loop->queue.front());
+    loop->queue.pop_front();
+    void *data = event.data.empty() ? nullptr : event.data.data();
+    // 分发过程中可能注册新的处理函数, 按下标遍历
+    for (size_t i = 0; i < loop->handlers.size(); i++) {
+      Handler h = loop->handlers[i];
+      if (matches(h, event.base, event.id)) {
+        h.handler(h.arg, event.base, event.id, data);
+      }
+    }
+  }
+  if (--loop->dispatchDepth == 0) {
+    auto &handlers = loop->handlers;
+    for (auto it = handlers.begin(); it != handlers.end();) {
+      it = it->removed ? handlers.erase(it) : it + 1;
+    }
+  }
+  return ESP_OK;
+}
+
+esp_err_t esp_event_handler_register_with(esp_event_loop_handle_t event_loop,
+                                          esp_event_base_t event_base,
+                                          int32_t event_id,
+                                          esp_event_handler_t event_handler,
+                                          void *event_handler_arg) {
+  if (event_loop == nullptr || event_handler == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *loop = static_cast<EventLoop *>(event_loop);
+  loop->handlers.push_back(
+      {event_base, event_id, event_handler, event_handler_arg, false});
+  return ESP_OK;
+}
+
+esp_err_t esp_event_handler_unregister_with(esp_event_loop_handle_t event_loop,
+                                            esp_event_base_t event_base,
+                                            int32_t event_id,
+                                            esp_event_handler_t event_handler) {
+  if (event_loop == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *loop = static_cast<EventLoop *>(event_loop);
+  for (auto &h : loop->handlers) {
+    if (h.base == event_base && h.id == event_id &&
+        h.handler == event_handler) {
+      h.removed = true;
+    }
+  }
+  if (loop->dispatchDepth == 0) {
+    auto &handlers = loop->handlers;
+    for (auto it = handlers.begin(); it != handlers.end();) {
+      it = it->removed ? handlers.erase(it) : it + 1;
+    }
+  }
+  return ESP_OK;
+}
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base,
+                                     int32_t event_id,
+                                     esp_event_handler_t event_handler,
+                                     void *event_handler_arg) {
+  if (s_defaultLoop == nullptr) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  return esp_event_handler_register_with(s_defaultLoop, event_base, event_id,
+                                         event_handler, event_handler_arg);
+}
+
+esp_err_t esp_event_handler_unregister(esp_event_base_t event_base,
+                                       int32_t event_id,
+                                       esp_event_handler_t event_handler) {
+  if (s_defaultLoop == nullptr) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  return esp_event_handler_unregister_with(s_defaultLoop, event_base, event_id,
+                                           event_handler);
+}
+
+esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop,
+                            esp_event_base_t event_base, int32_t event_id,
+                            const void *event_data, size_t event_data_size,
+                            TickType_t ticks_to_wait) {
+  (void)ticks_to_wait;
+  if (event_loop == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *loop = static_cast<EventLoop *>(event_loop);
+  // 主机上没有消费者并发运行, 队列满时无论等待多久都会超时
+  if (loop->queue.size() >= loop->queueSize) {
+    return ESP_ERR_TIMEOUT;
+  }
+  PendingEvent event{event_base, event_id, {}};
+  if (event_data != nullptr && event_data_size > 0) {
+    auto *bytes = static_cast<const uint8_t *>(event_data);
+    event.data.assign(bytes, bytes + event_data_size);
+  }
+  loop->queue.push_back(std::move(event));
+  return ESP_OK;
+}
+
+esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
+                         const void *event_data, size_t event_data_size,
+                         TickType_t ticks_to_wait) {
+  if (s_defaultLoop == nullptr) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  return esp_event_post_to(s_defaultLoop, event_base, event_id, event_data,
+                           event_data_size, ticks_to_wait);
+}
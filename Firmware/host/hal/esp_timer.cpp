@@ -0,0 +1,167 @@
+// esp_timer.cpp (host)
+// 虚拟时钟与软件定时器. 所有回调都在推进时钟的调用者上下文中同步执行,
+// 嵌套推进(例如回调里的 delay 或 I2C 传输)只移动时钟, 不再触发其他回调
+#include "esp_timer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "host_hal.h"
+
+struct esp_timer {
+  esp_timer_cb_t callback;
+  void *arg;
+  const char *name;
+  bool skipUnhandled;
+  bool active;
+  int64_t deadline;
+  uint64_t period;
+};
+
+static int64_t s_now = 0;
+static bool s_dispatching = false;
+static std::vector<esp_timer *> s_timers;
+
+static esp_timer *nextDue(int64_t until) {
+  esp_timer *next = nullptr;
+  for (auto *timer : s_timers) {
+    if (!timer->active || timer->deadline > until) {
+      continue;
+    }
+    if (next == nullptr || timer->deadline < next->deadline) {
+      next = timer;
+    }
+  }
+  return next;
+}
+
+int64_t host::now() { return s_now; }
+
+void host::advance(int64_t us) { advanceTo(s_now + us); }
+
+void host::advanceTo(int64_t timestampUs) {
+  if (s_dispatching) {
+    s_now = std::max(s_now, timestampUs);
+    return;
+  }
+  s_dispatching = true;
+  while (esp_timer *timer = nextDue(timestampUs)) {
+    s_now = std::max(s_now, timer->deadline);
+    if (timer->period > 0) {
+      timer->deadline += timer->period;
+    } else {
+      timer->active = false;
+    }
+    // 回调中可能删除定时器, 之后不能再访问 timer
+    auto callback = timer->callback;
+    auto arg = timer->arg;
+    callback(arg);
+    // 回调耗时超过周期时, 按 skip_unhandled_events 丢弃错过的触发,
+    // 只保留最近一次, 与 esp_timer 任务延迟后补发一次的行为一致
+    for (auto *t : s_timers) {
+      while (t->active && t->period > 0 && t->skipUnhandled &&
+             t->deadline + int64_t(t->period) <= s_now) {
+        t->deadline += t->period;
+      }
+    }
+  }
+  s_now = std::max(s_now, timestampUs);
+  s_dispatching = false;
+}
+
+void host::resetClock() {
+  for (auto *timer : s_timers) {
+    delete timer;
+  }
+  s_timers.clear();
+  s_now = 0;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args,
+                           esp_timer_handle_t *out_handle) {
+  if (create_args == nullptr || create_args->callback == nullptr ||
+      out_handle == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto *timer = new esp_timer{create_args->callback,
+                              create_args->arg,
+                              create_args->name,
+                              create_args->skip_unhandled_events,
+                              false,
+                              0,
+                              0};
+  s_timers.push_back(timer);
+  *out_handle = timer;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+  if (timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer->active) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->active = true;
+  timer->period = 0;
+  timer->deadline = s_now + timeout_us;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer,
+                                   uint64_t period) {
+  if (timer == nullptr || period == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer->active) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->active = true;
+  timer->period = period;
+  timer->deadline = s_now + period;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_restart(esp_timer_handle_t timer, uint64_t timeout_us) {
+  if (timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!timer->active) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (timer->period > 0) {
+    timer->period = timeout_us;
+  }
+  timer->deadline = s_now + timeout_us;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!timer->active) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->active = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  if (timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer->active) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  s_timers.erase(std::remove(s_timers.begin(), s_timers.end(), timer),
+                 s_timers.end());
+  delete timer;
+  return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+  return timer != nullptr && timer->active;
+}
+
+int64_t esp_timer_get_time(void) { return s_now; }
@@ -0,0 +1,6 @@
+// esp_types.h (host)
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
@@ -0,0 +1,122 @@
+// freertos.cpp (host)
+#include <deque>
+#include <string.h>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "host_hal.h"
+
+struct tskTaskControlBlock {
+  TaskFunction_t code;
+  const char *name;
+  void *parameters;
+};
+
+struct QueueDefinition {
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  std::deque<std::vector<uint8_t>> items;
+};
+
+static std::vector<tskTaskControlBlock *> s_tasks;
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName,
+                       uint32_t usStackDepth, void *pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask) {
+  (void)usStackDepth;
+  (void)uxPriority;
+  auto *task = new tskTaskControlBlock{pxTaskCode, pcName, pvParameters};
+  s_tasks.push_back(task);
+  if (pxCreatedTask) {
+    *pxCreatedTask = task;
+  }
+  return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode,
+                                   const char *pcName, uint32_t usStackDepth,
+                                   void *pvParameters, UBaseType_t uxPriority,
+                                   TaskHandle_t *pxCreatedTask,
+                                   BaseType_t xCoreID) {
+  (void)xCoreID;
+  return xTaskCreate(pxTaskCode, pcName, usStackDepth, pvParameters,
+                     uxPriority, pxCreatedTask);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+  for (auto it = s_tasks.begin(); it != s_tasks.end(); ++it) {
+    if (*it == xTaskToDelete) {
+      delete *it;
+      s_tasks.erase(it);
+      return;
+    }
+  }
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+  host::advance(int64_t(xTicksToDelay) * portTICK_PERIOD_MS * 1000);
+}
+
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime,
+                     TickType_t xTimeIncrement) {
+  *pxPreviousWakeTime += xTimeIncrement;
+  int64_t wake = int64_t(*pxPreviousWakeTime) * portTICK_PERIOD_MS * 1000;
+  if (wake > host::now()) {
+    host::advanceTo(wake);
+  }
+}
+
+TickType_t xTaskGetTickCount(void) {
+  return (TickType_t)(host::now() / 1000 / portTICK_PERIOD_MS);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+  (void)xTaskToNotify;
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit,
+                          TickType_t xTicksToWait) {
+  (void)xClearCountOnExit;
+  vTaskDelay(xTicksToWait);
+  return 0;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+  return new QueueDefinition{uxQueueLength, uxItemSize, {}};
+}
+
+void vQueueDelete(QueueHandle_t xQueue) { delete xQueue; }
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue,
+                      TickType_t xTicksToWait) {
+  (void)xTicksToWait;
+  if (xQueue->items.size() >= xQueue->length) {
+    return pdFALSE;
+  }
+  auto *bytes = static_cast<const uint8_t *>(pvItemToQueue);
+  xQueue->items.emplace_back(bytes, bytes + xQueue->itemSize);
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer,
+                         TickType_t xTicksToWait) {
+  (void)xTicksToWait;
+  if (xQueue->items.empty()) {
+    return pdFALSE;
+  }
+  memcpy(pvBuffer, xQueue->items.front().data(), xQueue->itemSize);
+  xQueue->items.pop_front();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue) {
+  xQueue->items.clear();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+  return xQueue->items.size();
+}
@@ -0,0 +1,38 @@
+// freertos/task.h (host)
+// 主机上不做任务调度: xTaskCreate 只登记任务, 由主机驱动程序自行推进各阶段
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tskTaskControlBlock *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskIDLE_PRIORITY ((UBaseType_t)0U)
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName,
+                       uint32_t usStackDepth, void *pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode,
+                                   const char *pcName, uint32_t usStackDepth,
+                                   void *pvParameters, UBaseType_t uxPriority,
+                                   TaskHandle_t *pxCreatedTask,
+                                   BaseType_t xCoreID);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+/// 推进虚拟时钟
+void vTaskDelay(TickType_t xTicksToDelay);
+/// 推进虚拟时钟到 *pxPreviousWakeTime + xTimeIncrement
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime,
+                     TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount(void);
+/// 任务不会运行, 通知只返回成功
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+/// 推进虚拟时钟, 与没有收到通知时一样超时返回0
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+// host_hal.h
+// 主机构建专用的控制接口: 虚拟时钟, 模拟I2C设备, GPIO电平
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace host {
+
+/**
+ * @brief 当前虚拟时间(微秒), 与 esp_timer_get_time 一致
+ */
+int64_t now();
+
+/**
+ * @brief 推进虚拟时钟, 按到期顺序同步执行期间到期的 esp_timer 回调
+ * @param us 推进的微秒数
+ */
+void advance(int64_t us);
+
+/**
+ * @brief 推进虚拟时钟到指定时间点
+ */
+void advanceTo(int64_t timestampUs);
+
+/**
+ * @brief 复位虚拟时钟并删除所有定时器
+ */
+void resetClock();
+
+/**
+ * @brief 模拟I2C从设备, 按寄存器读写建模, 读写指针自动递增
+ */
+class I2CDevice {
+public:
+  virtual ~I2CDevice() = default;
+  virtual void writeRegister(uint8_t reg, uint8_t value) {
+    (void)reg;
+    (void)value;
+  }
+  virtual uint8_t readRegister(uint8_t reg) = 0;
+};
+
+/**
+ * @brief 把模拟设备挂到总线上, 之后对该地址的访问都会应答
+ */
+void attachI2CDevice(uint8_t address, I2CDevice *device);
+void detachI2CDevice(uint8_t address);
+
+/**
+ * @brief 累计的I2C总线占用时间(微秒), 按当前时钟频率和传输字节数估算
+ */
+int64_t i2cBusTimeUs();
+
+/**
+ * @brief 一次I2C事务的总线时间(微秒): 写 txLength 字节, 重复起始后读 rxLength 字节
+ */
+int64_t i2cTransferTimeUs(uint32_t clock, size_t txLength, size_t rxLength);
+
+/**
+ * @brief 对模拟设备执行一次I2C事务, 写入的第一个字节为寄存器地址.
+ * 只累计总线时间, 不推进虚拟时钟
+ * @return 设备无应答返回false
+ */
+bool i2cTransfer(uint8_t address, const uint8_t *tx, size_t txLength,
+                 uint8_t *rx, size_t rxLength, uint32_t clock);
+
+/**
+ * @brief 设置输入引脚电平, 例如模拟按钮按下
+ */
+void setPinLevel(uint8_t pin, int level);
+int pinLevel(uint8_t pin);
+
+} // namespace host
@@ -0,0 +1,17 @@
+// soc/usb_serial_jtag_reg.h (host)
+// USB帧计数寄存器替身, 主机上恒定不变, 即视为未插入USB
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t host_usb_serial_jtag_fram_num;
+
+#ifdef __cplusplus
+}
+#endif
+
+#define USB_SERIAL_JTAG_FRAM_NUM_REG (&host_usb_serial_jtag_fram_num)
@@ -0,0 +1,80 @@
+// uart.cpp (host)
+#include "driver/uart.h"
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size,
+                              int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags) {
+  (void)uart_num;
+  (void)rx_buffer_size;
+  (void)tx_buffer_size;
+  (void)intr_alloc_flags;
+  if (uart_queue) {
+    *uart_queue = xQueueCreate(queue_size, sizeof(uart_event_t));
+  }
+  return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t uart_num) {
+  (void)uart_num;
+  return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num,
+                            const uart_config_t *uart_config) {
+  (void)uart_num;
+  (void)uart_config;
+  return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num,
+                       int rts_io_num, int cts_io_num) {
+  (void)uart_num;
+  (void)tx_io_num;
+  (void)rx_io_num;
+  (void)rts_io_num;
+  (void)cts_io_num;
+  return ESP_OK;
+}
+
+esp_err_t uart_enable_pattern_det_baud_intr(uart_port_t uart_num,
+                                            char pattern_chr, uint8_t chr_num,
+                                            int chr_tout, int post_idle,
+                                            int pre_idle) {
+  (void)uart_num;
+  (void)pattern_chr;
+  (void)chr_num;
+  (void)chr_tout;
+  (void)post_idle;
+  (void)pre_idle;
+  return ESP_OK;
+}
+
+esp_err_t uart_pattern_queue_reset(uart_port_t uart_num, int queue_length) {
+  (void)uart_num;
+  (void)queue_length;
+  return ESP_OK;
+}
+
+int uart_pattern_pop_pos(uart_port_t uart_num) {
+  (void)uart_num;
+  return -1;
+}
+
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length,
+                    TickType_t ticks_to_wait) {
+  (void)uart_num;
+  (void)buf;
+  (void)length;
+  (void)ticks_to_wait;
+  return 0;
+}
+
+esp_err_t uart_flush(uart_port_t uart_num) {
+  (void)uart_num;
+  return ESP_OK;
+}
+
+esp_err_t uart_flush_input(uart_port_t uart_num) {
+  (void)uart_num;
+  return ESP_OK;
+}
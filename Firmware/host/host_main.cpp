@@ -0,0 +1,279 @@
+// host_main.cpp
+// 主机冒烟程序: 用模拟地磁传感器启动上下文/传感器/LED/罗盘状态,
+// 在虚拟时钟下运行若干秒并打印统计信息.
+//
+//   mcompass_host [seconds] [qmc5883l|qmc5883p|mmc5883ma]
+//                 [trace|calibrate|idle]
+//
+// 第三个参数为 trace 时, 按 trace_def.h 的格式把传感器数据记录到 stdout,
+// 可作为 mcompass_replay 的输入.
+// 为 calibrate 时, 模拟带硬磁偏移和软磁畸变的传感器在三维空间中翻转,
+// 发出校准事件进入校准状态, 检查在线椭球校准的结果和状态切换.
+// 为 idle 时, 中间一半时间静止, 检查运动检测降低和恢复的采样与渲染频率.
+#include <FastLED.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board.h"
+#include "context.h"
+#include "event.h"
+#include "host_hal.h"
+#include "magnetometer_sim.h"
+#include "mock_i2c_bus.h"
+
+using namespace mcompass;
+
+static uint32_t s_renderWrites = 0;
+static esp_timer_handle_t s_sampleTimer;
+static esp_timer_handle_t s_renderTimer;
+
+/**
+ * @brief 主机上用定时器代替任务, 任务每轮重新计算周期, 这里在周期变化时重启定时器
+ */
+static void retime(esp_timer_handle_t timer, uint64_t periodUs) {
+  static uint64_t periods[2];
+  uint64_t &current = periods[timer == s_renderTimer];
+  if (current != periodUs) {
+    esp_timer_stop(timer);
+    esp_timer_start_periodic(timer, periodUs);
+    current = periodUs;
+  }
+}
+
+static void dispatcher(void *handler_arg, esp_event_base_t base, int32_t id,
+                       void *event_data) {
+  Context::getInstance().handleEvent((Event::Body *)event_data);
+}
+
+// calibrate 场景的畸变: 原始读数 = SOFT_IRON * 地磁 + HARD_IRON
+static const float HARD_IRON[3] = {420, -250, 180};
+static const float SOFT_IRON[3][3] = {
+    {1.15f, 0.08f, -0.04f}, {0.08f, 0.90f, 0.05f}, {-0.04f, 0.05f, 1.02f}};
+
+/**
+ * @brief 设备翻转时的地磁方向: 方位转一圈的同时俯仰在 ±75 度之间摆动
+ */
+static void tumbleField(int64_t us, float field[3]) {
+  float t = us / 1e6f;
+  float azimuth = t * 2.0f * M_PI / 3.0f;
+  float elevation = 1.3f * sinf(t * 2.0f * M_PI / 7.3f);
+  float earth[3] = {1800 * cosf(elevation) * cosf(azimuth),
+                    1800 * cosf(elevation) * sinf(azimuth),
+                    1800 * sinf(elevation)};
+  for (int i = 0; i < 3; i++) {
+    field[i] = HARD_IRON[i];
+    for (int j = 0; j < 3; j++) {
+      field[i] += SOFT_IRON[i][j] * earth[j];
+    }
+  }
+}
+
+static SensorModel parseModel(const char *name) {
+  if (strcmp(name, "qmc5883l") == 0) {
+    return SensorModel::QMC5883L;
+  }
+  if (strcmp(name, "mmc5883ma") == 0) {
+    return SensorModel::MMC5883MA;
+  }
+  return SensorModel::QMC5883P;
+}
+
+int main(int argc, char **argv) {
+  int seconds = argc > 1 ? atoi(argv[1]) : 10;
+  SensorModel model = parseModel(argc > 2 ? argv[2] : "qmc5883p");
+  trace::setEnabled(argc > 3 && strcmp(argv[3], "trace") == 0);
+  bool tumble = argc > 3 && strcmp(argv[3], "calibrate") == 0;
+  bool idle = argc > 3 && strcmp(argv[3], "idle") == 0;
+
+  host::MagnetometerSim magnetometer(model);
+  magnetometer.attach();
+  magnetometer.setHeading(0);
+
+  Context &context = Context::getInstance();
+  esp_event_loop_handle_t eventLoop;
+  esp_event_loop_args_t loop_args = {
+      .queue_size = 128,
+      .task_name = nullptr,
+  };
+  ESP_ERROR_CHECK(esp_event_loop_create(&loop_args, &eventLoop));
+  context.setEventLoop(eventLoop);
+  ESP_ERROR_CHECK(esp_event_handler_register_with(eventLoop, MCOMPASS_EVENT, 0,
+                                                  dispatcher, NULL));
+
+  preference::init(&context);
+  context.setSubscribeSource(Event::Source::SENSOR);
+  pixel::init(&context);
+  // 采样请求经模拟总线异步完成, 传输期间时钟照常推进
+  host::MockI2CBus i2cBus;
+  sensor::setTransport(&i2cBus);
+  sensor::init(&context);
+  if (!context.getHasSensor()) {
+    fprintf(stderr, "sensor init failed\n");
+    return 1;
+  }
+  context.setState(StateId::COMPASS);
+
+  // 与 board_impl.cpp 的 sensor_timer 一致
+  esp_timer_handle_t sensorTimer;
+  esp_timer_create_args_t sensorTimerArgs = {
+      .callback = [](void *) { sensor::tick(); },
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "sensor_timer",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&sensorTimerArgs, &sensorTimer));
+  source::attach(Event::Source::SENSOR, sensorTimer, SENSOR_TICK_US);
+
+  // 主机上采样任务不会运行, 用定时器按相同周期查询数据就绪
+  esp_timer_create_args_t sampleTimerArgs = {
+      .callback =
+          [](void *) {
+            if (source::isRunning(Event::Source::SENSOR)) {
+              sensor::sample();
+            }
+            retime(s_sampleTimer, sensor::getPollMs() * 1000);
+          },
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "sensor_sample",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&sampleTimerArgs, &s_sampleTimer));
+  retime(s_sampleTimer, sensor::getPollMs() * 1000);
+
+  // 主机上校准任务不会运行, 用定时器按相同周期求解
+  esp_timer_handle_t calibratorTimer;
+  esp_timer_create_args_t calibratorTimerArgs = {
+      .callback = [](void *) { calibrator::process(); },
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "calibrator",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&calibratorTimerArgs, &calibratorTimer));
+  ESP_ERROR_CHECK(
+      esp_timer_start_periodic(calibratorTimer, CALIBRATOR_SOLVE_MS * 1000));
+
+  // 主机上任务不会运行, 用定时器按帧率驱动渲染任务的每一帧
+  esp_timer_create_args_t renderTimerArgs = {
+      .callback =
+          [](void *) {
+            if (render::frame()) {
+              s_renderWrites++;
+            }
+            retime(s_renderTimer, 1000000 / render::getFps());
+          },
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "render",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&renderTimerArgs, &s_renderTimer));
+  retime(s_renderTimer, 1000000 / render::getFps());
+
+  if (tumble) {
+    // 与按钮六击相同, 校准状态不阻塞事件循环, 结果合格后自动回到罗盘状态
+    Event::Body event;
+    event.type = Event::Type::SENSOR_CALIBRATE;
+    event.source = Event::Source::BUTTON;
+    context.postEvent(event);
+  }
+
+  // 每 10ms 转动 1 度, 并处理事件队列
+  int64_t end = host::now() + int64_t(seconds) * 1000000;
+  float heading = 0;
+  int64_t stillFrom = host::now() + int64_t(seconds) * 250000;
+  int64_t stillUntil = host::now() + int64_t(seconds) * 750000;
+  while (host::now() < end) {
+    host::advance(10000);
+    if (idle && host::now() >= stillFrom && host::now() < stillUntil) {
+      esp_event_loop_run(eventLoop, 0);
+      continue;
+    }
+    heading += 1;
+    if (heading >= 360) {
+      heading -= 360;
+    }
+    if (tumble) {
+      float field[3];
+      tumbleField(host::now(), field);
+      magnetometer.setField((int16_t)lroundf(field[0]),
+                            (int16_t)lroundf(field[1]),
+                            (int16_t)lroundf(field[2]));
+    } else {
+      magnetometer.setHeading(heading);
+    }
+    esp_event_loop_run(eventLoop, 0);
+  }
+
+  printf("virtual_time_us=%lld\n", (long long)host::now());
+  printf("sensor_reads=%u\n", magnetometer.sampleReads());
+  sensor::SampleStats sampleStats = sensor::stats();
+  printf("sensor_samples=%u overruns=%u not_ready=%u odr_retries=%u\n",
+         sampleStats.samples, sampleStats.overruns, sampleStats.notReady,
+         sampleStats.odrRetries);
+  printf("i2c_requests=%u failed=%u rejected=%u\n", i2cBus.completed(),
+         i2cBus.failed(), i2cBus.rejected());
+  printf("render_fps=%u render_writes=%u\n", render::getFps(),
+         s_renderWrites);
+  motion::Stats motionStats = motion::stats();
+  printf("motion stationary=%d idles=%u wakes=%u variance=%u poll_ms=%u "
+         "sensor_period_us=%llu\n",
+         motion::isStationary(), motionStats.idles, motionStats.wakes,
+         motionStats.variance, sensor::getPollMs(),
+         (unsigned long long)source::getPeriod(Event::Source::SENSOR));
+  printf("led_shows=%u\n", host::ledShowCount());
+  printf("i2c_bus_time_us=%lld\n", (long long)host::i2cBusTimeUs());
+  printf("last_azimuth=%.2f heading=%.2f\n",
+         angle::toDegrees(context.getAzimuth()), heading);
+  calibrator::Stats calibratorStats = calibrator::stats();
+  printf("calibrator accepted=%u solves=%u failed=%u applied=%u saved=%u\n",
+         calibratorStats.accepted, calibratorStats.solves,
+         calibratorStats.failed, calibratorStats.applied,
+         calibratorStats.saved);
+  calibrator::Result calibration;
+  if (calibrator::last(calibration)) {
+    printf("calibration quality=%.3f coverage=%.3f residual=%.4f "
+           "offsets=%.1f,%.1f,%.1f\n",
+           calibration.quality, calibration.coverage, calibration.residual,
+           calibration.offsets[0], calibration.offsets[1],
+           calibration.offsets[2]);
+    if (tumble) {
+      // 校准矩阵乘以软磁畸变应接近 I/1800 的旋转, 检查其奇异值的离散程度
+      float product[3][3];
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          product[i][j] = 0;
+          for (int k = 0; k < 3; k++) {
+            product[i][j] += calibration.matrix[i][k] * SOFT_IRON[k][j] * 1800;
+          }
+        }
+      }
+      float worst = 0;
+      for (int j = 0; j < 3; j++) {
+        float norm = sqrtf(product[0][j] * product[0][j] +
+                           product[1][j] * product[1][j] +
+                           product[2][j] * product[2][j]);
+        worst = fmaxf(worst, fabsf(norm - 1));
+      }
+      printf("calibration hard_iron_error=%.1f,%.1f,%.1f "
+             "soft_iron_column_error=%.4f\n",
+             calibration.offsets[0] - HARD_IRON[0],
+             calibration.offsets[1] - HARD_IRON[1],
+             calibration.offsets[2] - HARD_IRON[2], worst);
+    }
+  }
+  char metricsJson[METRICS_JSON_SIZE];
+  if (metrics::toJson(metricsJson, sizeof(metricsJson))) {
+    printf("metrics=%s\n", metricsJson);
+  }
+  if (metrics::eventsToJson(metricsJson, sizeof(metricsJson))) {
+    printf("event_metrics=%s\n", metricsJson);
+  }
+  if (metrics::bootToJson(metricsJson, sizeof(metricsJson))) {
+    printf("boot_metrics=%s\n", metricsJson);
+  }
+  char transitions[256];
+  context.logTransitions(transitions, sizeof(transitions));
+  printf("transitions=%s\n", transitions);
+  return 0;
+}
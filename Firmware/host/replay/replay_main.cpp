@@ -0,0 +1,305 @@
+// replay_main.cpp
+// 回放 trace_def.h 格式的记录: 地磁原始读数经模拟传感器和 sensor::sample 进入
+// 采样环形缓冲, 由 sensor::getAzimuth 计算方位角,
+// 写入方位角邮箱, 由按帧率运行的渲染帧经弹簧插值输出到像素层;
+// NMEA 语句送入 GPS 解析器.
+// 结果以 JSON 输出到 stdout.
+//
+//   mcompass_replay <trace> [--speed N] [--model qmc5883l|qmc5883p|mmc5883ma]
+//
+// --speed 0 (默认) 表示不限速, N>0 表示按 N 倍实时速度回放.
+#include <FastLED.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "context.h"
+#include "event.h"
+#include "host_hal.h"
+#include "magnetometer_sim.h"
+#include "mock_i2c_bus.h"
+
+using namespace mcompass;
+
+namespace {
+
+struct Record {
+  char kind; // 'S', 'M' 或 'N'
+  int64_t timestamp;
+  int16_t xyz[3];
+  std::string text;
+};
+
+bool parseModel(const std::string &name, SensorModel &model) {
+  std::string lower = name;
+  std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+  if (lower == "qmc5883l") {
+    model = SensorModel::QMC5883L;
+  } else if (lower == "qmc5883p") {
+    model = SensorModel::QMC5883P;
+  } else if (lower == "mmc5883ma") {
+    model = SensorModel::MMC5883MA;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief 读取记录文件, 忽略不以 #S/#M/#N 开头的行
+ */
+bool loadTrace(const char *path, std::vector<Record> &records) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) {
+      line.pop_back();
+    }
+    if (line.size() < 4 || line[0] != '#' || line[2] != ' ') {
+      continue;
+    }
+    Record record{line[1], 0, {0, 0, 0}, ""};
+    const char *p = line.c_str() + 3;
+    char *end;
+    record.timestamp = strtoll(p, &end, 10);
+    if (end == p) {
+      continue;
+    }
+    p = end;
+    while (*p == ' ') {
+      p++;
+    }
+    if (record.kind == 'M') {
+      int x, y, z;
+      if (sscanf(p, "%d %d %d", &x, &y, &z) != 3) {
+        continue;
+      }
+      record.xyz[0] = x;
+      record.xyz[1] = y;
+      record.xyz[2] = z;
+    } else if (record.kind == 'N' || record.kind == 'S') {
+      record.text = p;
+    } else {
+      continue;
+    }
+    records.push_back(record);
+  }
+  return true;
+}
+
+float angleDistance(float a, float b) {
+  float d = fabsf(a - b);
+  return d > 180.0f ? 360.0f - d : d;
+}
+
+void dispatcher(void *handler_arg, esp_event_base_t base, int32_t id,
+                void *event_data) {
+  Context::getInstance().handleEvent((Event::Body *)event_data);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "usage: %s <trace> [--speed N] [--model "
+            "qmc5883l|qmc5883p|mmc5883ma]\n",
+            argv[0]);
+    return 2;
+  }
+  const char *tracePath = argv[1];
+  double speed = 0;
+  bool modelOverride = false;
+  SensorModel model = SensorModel::QMC5883P;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--speed") == 0) {
+      speed = atof(argv[i + 1]);
+    } else if (strcmp(argv[i], "--model") == 0) {
+      modelOverride = parseModel(argv[i + 1], model);
+    }
+  }
+
+  std::vector<Record> records;
+  if (!loadTrace(tracePath, records) || records.empty()) {
+    fprintf(stderr, "no records in %s\n", tracePath);
+    return 1;
+  }
+  bool hasNmea = false;
+  for (const Record &record : records) {
+    if (record.kind == 'S' && !modelOverride) {
+      parseModel(record.text, model);
+    }
+    hasNmea |= record.kind == 'N';
+  }
+
+  host::MagnetometerSim magnetometer(model);
+  magnetometer.attach();
+
+  Context &context = Context::getInstance();
+  esp_event_loop_handle_t eventLoop;
+  esp_event_loop_args_t loop_args = {
+      .queue_size = 128,
+      .task_name = nullptr,
+  };
+  ESP_ERROR_CHECK(esp_event_loop_create(&loop_args, &eventLoop));
+  context.setEventLoop(eventLoop);
+  ESP_ERROR_CHECK(esp_event_handler_register_with(eventLoop, MCOMPASS_EVENT, 0,
+                                                  dispatcher, NULL));
+  preference::init(&context);
+  if (hasNmea) {
+    // 有GPS数据时按GPS型号回放, 指向出生点
+    context.setModel(Model::GPS);
+    context.setWorkType(WorkType::SPAWN);
+  }
+  context.setSubscribeSource(Event::Source::SENSOR);
+  pixel::init(&context);
+  host::MockI2CBus i2cBus;
+  sensor::setTransport(&i2cBus);
+  sensor::init(&context);
+  if (!context.getHasSensor()) {
+    fprintf(stderr, "sensor init failed\n");
+    return 1;
+  }
+  if (hasNmea) {
+    gps::init(&context);
+  }
+  context.setState(StateId::COMPASS);
+
+  // 主机上任务不会运行, 用定时器按帧率驱动渲染任务的每一帧
+  esp_timer_handle_t renderTimer;
+  esp_timer_create_args_t renderTimerArgs = {
+      .callback = [](void *) { render::frame(); },
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "render",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&renderTimerArgs, &renderTimer));
+  ESP_ERROR_CHECK(
+      esp_timer_start_periodic(renderTimer, 1000000 / render::getFps()));
+
+  uint32_t samples = 0;
+  uint32_t nmeaLines = 0;
+  uint32_t frameChanges = 0;
+  uint32_t reversals = 0;
+  double errorSum = 0;
+  float errorMax = 0;
+  std::vector<double> sampleNs;
+  sampleNs.reserve(records.size());
+  std::vector<CRGB> lastFrame(NUM_LEDS);
+  float lastInterpolated = 0;
+  float lastDelta = 0;
+  uint32_t showsBefore = host::ledShowCount();
+
+  const int64_t traceStart = records.front().timestamp;
+  const int64_t clockStart = host::now();
+  auto wallStart = std::chrono::steady_clock::now();
+
+  for (const Record &record : records) {
+    int64_t offset = record.timestamp - traceStart;
+    if (clockStart + offset > host::now()) {
+      host::advanceTo(clockStart + offset);
+    }
+    if (speed > 0) {
+      std::this_thread::sleep_until(
+          wallStart + std::chrono::microseconds(int64_t(offset / speed)));
+    }
+
+    if (record.kind == 'M') {
+      magnetometer.setField(record.xyz[0], record.xyz[1], record.xyz[2]);
+      auto start = std::chrono::steady_clock::now();
+      // 采样任务读入环形缓冲, 再经 board_impl.cpp 的 sensor_timer 处理链
+      sensor::sample();
+      i2cBus.flush();
+      float target = angle::toDegrees(sensor::tick());
+      float interpolated = angle::toDegrees(spring::getAzimuth());
+      sampleNs.push_back(std::chrono::duration<double, std::nano>(
+                             std::chrono::steady_clock::now() - start)
+                             .count());
+
+      float error = angleDistance(interpolated, target);
+      errorSum += error;
+      errorMax = std::max(errorMax, error);
+      float delta = interpolated - lastInterpolated;
+      if (delta > 180.0f) {
+        delta -= 360.0f;
+      } else if (delta < -180.0f) {
+        delta += 360.0f;
+      }
+      // 指针来回摆动: 相邻两步方向相反且幅度超过半度
+      if (samples > 0 && fabsf(delta) > 0.5f && fabsf(lastDelta) > 0.5f &&
+          (delta > 0) != (lastDelta > 0)) {
+        reversals++;
+      }
+      if (fabsf(delta) > 0.5f) {
+        lastDelta = delta;
+      }
+      lastInterpolated = interpolated;
+      samples++;
+    } else if (record.kind == 'N') {
+      gps::feed(record.text.c_str(), record.text.size());
+      esp_event_loop_run(eventLoop, 0);
+      nmeaLines++;
+    }
+
+    if (host::ledShowCount() != showsBefore) {
+      showsBefore = host::ledShowCount();
+      if (memcmp(lastFrame.data(), host::ledFrame(),
+                 sizeof(CRGB) * NUM_LEDS) != 0) {
+        memcpy(lastFrame.data(), host::ledFrame(), sizeof(CRGB) * NUM_LEDS);
+        frameChanges++;
+      }
+    }
+  }
+
+  double wallSeconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - wallStart)
+                           .count();
+  double traceSeconds = (records.back().timestamp - traceStart) / 1e6;
+  std::sort(sampleNs.begin(), sampleNs.end());
+  double meanNs = 0;
+  for (double ns : sampleNs) {
+    meanNs += ns;
+  }
+  meanNs = sampleNs.empty() ? 0 : meanNs / sampleNs.size();
+  double p99Ns =
+      sampleNs.empty() ? 0 : sampleNs[(sampleNs.size() - 1) * 99 / 100];
+
+  printf("{\n");
+  printf("  \"trace\": \"%s\",\n", tracePath);
+  printf("  \"sensor_model\": \"%s\",\n",
+         utils::sensorModel2Str(model).c_str());
+  printf("  \"trace_seconds\": %.3f,\n", traceSeconds);
+  printf("  \"wall_seconds\": %.3f,\n", wallSeconds);
+  printf("  \"speedup\": %.1f,\n",
+         wallSeconds > 0 ? traceSeconds / wallSeconds : 0.0);
+  printf("  \"samples\": %u,\n", samples);
+  printf("  \"nmea_lines\": %u,\n", nmeaLines);
+  printf("  \"led_shows\": %u,\n", host::ledShowCount());
+  printf("  \"frame_changes\": %u,\n", frameChanges);
+  printf("  \"pointer_reversals\": %u,\n", reversals);
+  printf("  \"mean_lag_deg\": %.2f,\n", samples ? errorSum / samples : 0.0);
+  printf("  \"max_lag_deg\": %.2f,\n", errorMax);
+  printf("  \"sample_ns_mean\": %.1f,\n", meanNs);
+  printf("  \"sample_ns_p99\": %.1f,\n", p99Ns);
+  printf("  \"gps_fixed\": %s,\n", context.getIsGPSFixed() ? "true" : "false");
+  char metricsJson[METRICS_JSON_SIZE];
+  printf("  \"metrics\": %s,\n",
+         metrics::toJson(metricsJson, sizeof(metricsJson)) ? metricsJson
+                                                            : "null");
+  printf("  \"event_metrics\": %s\n",
+         metrics::eventsToJson(metricsJson, sizeof(metricsJson)) ? metricsJson
+                                                                 : "null");
+  printf("}\n");
+  return 0;
+}
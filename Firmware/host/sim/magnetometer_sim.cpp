@@ -0,0 +1,122 @@
+// magnetometer_sim.cpp
+#include "magnetometer_sim.h"
+
+#include <math.h>
+
+using namespace mcompass;
+
+namespace host {
+
+MagnetometerSim::MagnetometerSim(SensorModel model) : _model(model) {}
+
+uint8_t MagnetometerSim::address() const {
+  switch (_model) {
+  case SensorModel::QMC5883L:
+    return 0x0D;
+  case SensorModel::QMC5883P:
+    return 0x2C;
+  case SensorModel::MMC5883MA:
+    return 0x30;
+  default:
+    return 0x00;
+  }
+}
+
+void MagnetometerSim::attach() { attachI2CDevice(address(), this); }
+
+void MagnetometerSim::detach() { detachI2CDevice(address()); }
+
+void MagnetometerSim::setField(int16_t x, int16_t y, int16_t z) {
+  _field[0] = x;
+  _field[1] = y;
+  _field[2] = z;
+  _fieldChanged = true;
+}
+
+void MagnetometerSim::setHeading(float heading, int16_t magnitude) {
+  // 与 MagnetometerTraits.h 中各型号的轴向互逆
+  float raw = heading;
+  switch (_model) {
+  case SensorModel::QMC5883P:
+    raw = heading - 90;
+    break;
+  case SensorModel::QMC5883L:
+    raw = 360 - heading;
+    break;
+  default:
+    break;
+  }
+  float rad = raw * M_PI / 180.0f;
+  setField((int16_t)lroundf(magnitude * cosf(rad)),
+           (int16_t)lroundf(magnitude * sinf(rad)), 0);
+}
+
+void MagnetometerSim::writeRegister(uint8_t reg, uint8_t value) {
+  if (reg < sizeof(_control)) {
+    _control[reg] = value;
+  }
+}
+
+int64_t MagnetometerSim::conversionPeriodUs() const {
+  // QMC5883L 0x09 / QMC5883P 0x0A 的 bit[3:2]: 10Hz, 50Hz, 100Hz, 200Hz
+  static const int64_t periods[4] = {100000, 20000, 10000, 5000};
+  uint8_t control = _model == SensorModel::QMC5883P ? _control[0x0A]
+                                                    : _control[0x09];
+  return periods[(control >> 2) & 0x03];
+}
+
+bool MagnetometerSim::dataReady() const {
+  if (_fieldChanged || _lastDataRead < 0) {
+    return true;
+  }
+  int64_t period = conversionPeriodUs();
+  return host::now() / period > _lastDataRead / period;
+}
+
+uint8_t MagnetometerSim::readRegister(uint8_t reg) {
+  // 各型号的数据起始寄存器, 芯片ID寄存器与状态寄存器
+  uint8_t dataStart = 0x00;
+  switch (_model) {
+  case SensorModel::QMC5883P:
+    if (reg == 0x00) {
+      return 0x80;
+    }
+    if (reg == 0x09) {
+      return dataReady() ? 0x01 : 0x00;
+    }
+    dataStart = 0x01;
+    break;
+  case SensorModel::QMC5883L:
+    if (reg == 0x0D) {
+      return 0xFF;
+    }
+    if (reg == 0x06) {
+      return dataReady() ? 0x01 : 0x00;
+    }
+    break;
+  case SensorModel::MMC5883MA:
+    // 测量完成位始终置位
+    if (reg == 0x07) {
+      return 0xFF;
+    }
+    if (reg == 0x2F) {
+      return 0x0C;
+    }
+    break;
+  default:
+    return 0;
+  }
+  if (reg < dataStart || reg >= dataStart + 6) {
+    return reg < sizeof(_control) ? _control[reg] : 0;
+  }
+  int offset = reg - dataStart;
+  if (offset == 0) {
+    _sampleReads++;
+    _lastDataRead = host::now();
+    _fieldChanged = false;
+  }
+  uint16_t value = (uint16_t)_field[offset / 2];
+  return offset % 2 ? value >> 8 : value & 0xFF;
+}
+
+} // namespace host
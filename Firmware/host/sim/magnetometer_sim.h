@@ -0,0 +1,65 @@
+// magnetometer_sim.h
+// 主机构建用的地磁传感器寄存器模型, 覆盖固件支持的三种型号
+#pragma once
+
+#include <stdint.h>
+
+#include "host_hal.h"
+#include "sensor_def.h"
+
+namespace host {
+
+class MagnetometerSim : public I2CDevice {
+public:
+  explicit MagnetometerSim(mcompass::SensorModel model);
+
+  /**
+   * @brief 挂载到型号对应的I2C地址
+   */
+  void attach();
+  void detach();
+
+  mcompass::SensorModel model() const { return _model; }
+  uint8_t address() const;
+
+  /**
+   * @brief 直接设置三轴原始读数(LSB), 同时置位数据就绪
+   */
+  void setField(int16_t x, int16_t y, int16_t z);
+
+  /**
+   * @brief 按固件的轴向换算设置原始读数,
+   * 使 sensor::getAzimuth() 在无校准时返回 heading
+   * @param heading 方位角(度)
+   * @param magnitude 水平分量幅值(LSB)
+   */
+  void setHeading(float heading, int16_t magnitude = 2000);
+
+  /**
+   * @brief 数据寄存器被读取的次数(按6字节突发计)
+   */
+  uint32_t sampleReads() const { return _sampleReads; }
+
+  void writeRegister(uint8_t reg, uint8_t value) override;
+  uint8_t readRegister(uint8_t reg) override;
+
+private:
+  /**
+   * @brief 按控制寄存器中的ODR换算的转换周期(微秒)
+   */
+  int64_t conversionPeriodUs() const;
+  /**
+   * @brief 上次读取数据之后是否有新的转换结果
+   */
+  bool dataReady() const;
+
+  mcompass::SensorModel _model;
+  int16_t _field[3] = {0, 0, 0};
+  // 连续模式下每个转换周期结束时置位数据就绪, 读取数据寄存器后清除
+  int64_t _lastDataRead = -1;
+  bool _fieldChanged = true;
+  uint8_t _control[0x10] = {0};
+  uint32_t _sampleReads = 0;
+};
+
+} // namespace host
@@ -0,0 +1,94 @@
+// mock_i2c_bus.cpp
+#include "mock_i2c_bus.h"
+
+#include "host_hal.h"
+
+namespace host {
+
+MockI2CBus::MockI2CBus(uint32_t clock, size_t depth)
+    : _clock(clock), _depth(depth) {
+  esp_timer_create_args_t args = {.callback = onTimer,
+                                  .arg = this,
+                                  .dispatch_method = ESP_TIMER_TASK,
+                                  .name = "mock_i2c",
+                                  .skip_unhandled_events = true};
+  esp_timer_create(&args, &_timer);
+}
+
+MockI2CBus::~MockI2CBus() {
+  if (_timer) {
+    esp_timer_stop(_timer);
+    esp_timer_delete(_timer);
+  }
+}
+
+bool MockI2CBus::readRegisters(uint8_t address, uint8_t reg, uint8_t *buffer,
+                               size_t length, Callback callback, void *arg) {
+  return submit({address, reg, 0, buffer, length, callback, arg});
+}
+
+bool MockI2CBus::writeRegister(uint8_t address, uint8_t reg, uint8_t value,
+                               Callback callback, void *arg) {
+  return submit({address, reg, value, nullptr, 0, callback, arg});
+}
+
+bool MockI2CBus::submit(const Request &request) {
+  if (_queue.size() >= _depth) {
+    _rejected++;
+    return false;
+  }
+  _queue.push_back(request);
+  startNext();
+  return true;
+}
+
+void MockI2CBus::startNext() {
+  if (_transferring || _queue.empty()) {
+    return;
+  }
+  const Request &request = _queue.front();
+  size_t txLength = request.buffer ? 1 : 2;
+  _transferring = true;
+  esp_timer_start_once(_timer,
+                       i2cTransferTimeUs(_clock, txLength, request.length));
+}
+
+void MockI2CBus::completeFront() {
+  Request request = _queue.front();
+  _queue.pop_front();
+  _transferring = false;
+  bool ok;
+  if (request.buffer) {
+    ok = i2cTransfer(request.address, &request.reg, 1, request.buffer,
+                     request.length, _clock);
+  } else {
+    uint8_t data[2] = {request.reg, request.value};
+    ok = i2cTransfer(request.address, data, sizeof(data), nullptr, 0, _clock);
+  }
+  _completed++;
+  if (!ok) {
+    _failed++;
+  }
+  if (request.callback) {
+    request.callback(request.arg, ok);
+  }
+}
+
+void MockI2CBus::onTimer(void *self) {
+  MockI2CBus *bus = static_cast<MockI2CBus *>(self);
+  bus->completeFront();
+  bus->startNext();
+}
+
+void MockI2CBus::flush() {
+  esp_timer_stop(_timer);
+  _transferring = false;
+  while (!_queue.empty()) {
+    completeFront();
+    // 回调中提交的请求会尝试启动定时器, 这里直接完成
+    esp_timer_stop(_timer);
+    _transferring = false;
+  }
+}
+
+} // namespace host
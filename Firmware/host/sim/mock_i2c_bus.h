@@ -0,0 +1,71 @@
+// mock_i2c_bus.h
+// 主机构建用的异步I2C总线: 实现 I2CTransport, 请求排队后按总线时钟在虚拟时钟上
+// 依次完成, 完成时在 esp_timer 回调中执行传输并调用回调, 访问 attachI2CDevice
+// 挂载的模拟设备. 用于在没有芯片的情况下验证驱动的异步读取流程
+#pragma once
+
+#include <deque>
+#include <stdint.h>
+
+#include "I2CTransport.h"
+#include "esp_timer.h"
+
+namespace host {
+
+class MockI2CBus : public I2CTransport {
+public:
+  explicit MockI2CBus(uint32_t clock = 100000, size_t depth = 8);
+  ~MockI2CBus() override;
+
+  bool readRegisters(uint8_t address, uint8_t reg, uint8_t *buffer,
+                     size_t length, Callback callback, void *arg) override;
+  bool writeRegister(uint8_t address, uint8_t reg, uint8_t value,
+                     Callback callback = nullptr,
+                     void *arg = nullptr) override;
+
+  /**
+   * @brief 不等待总线时间, 立即完成所有排队的请求(包括回调中新提交的请求)
+   */
+  void flush();
+
+  /**
+   * @brief 排队中(含正在传输)的请求数
+   */
+  size_t pending() const { return _queue.size(); }
+  /**
+   * @brief 已完成的请求数, 以及其中设备无应答的次数
+   */
+  uint32_t completed() const { return _completed; }
+  uint32_t failed() const { return _failed; }
+  /**
+   * @brief 队列满被拒绝的请求数
+   */
+  uint32_t rejected() const { return _rejected; }
+
+private:
+  struct Request {
+    uint8_t address;
+    uint8_t reg;
+    uint8_t value;
+    uint8_t *buffer;
+    size_t length;
+    Callback callback;
+    void *arg;
+  };
+
+  bool submit(const Request &request);
+  void startNext();
+  void completeFront();
+  static void onTimer(void *self);
+
+  uint32_t _clock;
+  size_t _depth;
+  std::deque<Request> _queue;
+  esp_timer_handle_t _timer = nullptr;
+  bool _transferring = false;
+  uint32_t _completed = 0;
+  uint32_t _failed = 0;
+  uint32_t _rejected = 0;
+};
+
+} // namespace host
@@ -7,6 +7,14 @@ namespace mcompass {
     class Context; 
 }
 
+/// 状态编号, 每个状态只有一个静态实例, 切换状态不分配内存
+enum class StateId : uint8_t {
+    COMPASS,        // 罗盘
+    CALIBRATING,    // 传感器校准
+    FACTORY_RESET,  // 恢复出厂设置
+    COUNT,          // 状态数量, 也表示尚未进入任何状态
+};
+
 class IState {
 public:
     virtual ~IState() {}
@@ -0,0 +1,41 @@
+#pragma once
+#include <math.h>
+#include <stdint.h>
+
+#include "FixedMath.h"
+
+/**
+ * 方位角定点数: 单位0.01度, 范围[0, 36000).
+ * 从传感器驱动经方位角邮箱, 弹簧插值一直传到像素层, 中途不再截断到整数度
+ */
+namespace mcompass {
+namespace angle {
+
+typedef int32_t Centideg;
+
+// 一周
+constexpr Centideg FULL_TURN = fixed::kTurnCentideg;
+// 一度
+constexpr Centideg PER_DEGREE = 100;
+
+/**
+ * @brief 归一化到[0, FULL_TURN)
+ */
+inline Centideg normalize(int32_t value) {
+  return fixed::wrap(value, FULL_TURN);
+}
+
+/**
+ * @brief 度数转定点数, 四舍五入并归一化
+ */
+inline Centideg fromDegrees(float degrees) {
+  return normalize((int32_t)floorf(degrees * PER_DEGREE + 0.5f));
+}
+
+/**
+ * @brief 定点数转度数
+ */
+inline float toDegrees(Centideg value) { return value / (float)PER_DEGREE; }
+
+} // namespace angle
+} // namespace mcompass
@@ -4,12 +4,21 @@
 
 #include "bluetooth_def.h"
 #include "button_def.h"
+#include "calibrator_def.h"
 #include "common.h"
 #include "gps_def.h"
 #include "macro_def.h"
+#include "mailbox_def.h"
+#include "mathbench_def.h"
+#include "metrics_def.h"
+#include "motion_def.h"
 #include "pixel_def.h"
 #include "preference_def.h"
+#include "render_def.h"
 #include "sensor_def.h"
+#include "source_def.h"
+#include "spring_def.h"
+#include "trace_def.h"
 #include "utils.h"
 #include "web_server_def.h"
 
@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * 在线椭球校准: 传感器定时器从采样环形缓冲取出的每个原始采样都送入 feed,
+ * 以 O(1) 的代价累加椭球方程 ax²+by²+cz²+2dxy+2exz+2fyz+2gx+2hy+2iz=1
+ * 的最小二乘法方程(带指数遗忘). 后台任务定期求解, 得到硬磁偏移和3x3软磁矩阵,
+ * 质量分足够时由传感器定时器应用, 并通过 preference::setCalibration 保存.
+ * 罗盘状态下持续运行, 不需要进入校准状态; 校准状态用 begin 重新开始,
+ * 由 progress 显示进度, 结果应用后回到罗盘状态.
+ */
+namespace mcompass {
+namespace calibrator {
+
+struct Result {
+  float offsets[3];   // 硬磁偏移(原始读数)
+  float matrix[3][3]; // 软磁校准矩阵, 校准后的磁场幅值为1
+  float quality;      // 质量分 0~1, 等于 coverage * fitness
+  float coverage;     // 方向覆盖度 0~1, 只在一个平面内转动时接近0
+  float residual;     // 校准后半径的相对误差(RMS)
+  float samples;      // 参与拟合的加权采样数
+};
+
+struct Stats {
+  uint32_t accepted; // 采纳的采样数, 与上一个采纳的采样太接近的不计入
+  uint32_t solves;   // 求解次数
+  uint32_t failed;   // 方程奇异或结果不是椭球的次数
+  uint32_t applied;  // 交给传感器应用的次数
+  uint32_t saved;    // 保存到 preference 的次数
+};
+
+/**
+ * @brief 创建后台求解任务
+ * @param savedQuality 已保存的校准数据的质量分, 新结果明显更好时才提前保存
+ */
+void init(float savedQuality);
+
+/**
+ * @brief 清空累加的数据
+ */
+void reset();
+
+/**
+ * @brief 开始一次手动校准: 清空累加的数据和之前的结果, 丢弃正在进行的求解,
+ * 第一个达到 CALIBRATOR_MIN_QUALITY 的结果即被应用并保存
+ */
+void begin();
+
+/**
+ * @brief 结束手动校准. 没有得到合格结果(取消或超时)时恢复 begin 之前的质量分,
+ * 之后的后台结果仍需明显优于已保存的校准数据才会替换它
+ */
+void end();
+
+/**
+ * @brief 手动校准的进度 0~1, 即 begin 之后最近一次求解的方向覆盖度
+ */
+float progress();
+
+/**
+ * @brief 送入一个原始采样, 只能在一个任务中调用(传感器定时器)
+ */
+void feed(const int16_t xyz[3]);
+
+/**
+ * @brief 用当前累加的数据求解, 不改变状态
+ * @return 采样不足, 方程奇异或结果不是椭球时返回false
+ */
+bool solve(Result &out);
+
+/**
+ * @brief 后台任务的一次处理: 有足够的新采样时求解,
+ * 质量分足够则交给传感器应用, 必要时保存. 主机构建由定时器驱动
+ */
+void process();
+
+/**
+ * @brief 取出待应用的校准结果, 由传感器定时器调用
+ * @return 没有新结果返回false
+ */
+bool take(Result &out);
+
+/**
+ * @brief 最近一次成功求解的结果, 不论是否被应用
+ */
+bool last(Result &out);
+
+Stats stats();
+
+} // namespace calibrator
+} // namespace mcompass
@@ -1,198 +1,75 @@
 #pragma once
 #include <stdint.h>
-uint32_t frames[27][42] = {
-    {
-        0, 0,        0,        0,        0,        0, 0, 0,        0,
-        0, 0,        0,        0,        0,        0, 0, 0x4f4d4d, 0,
-        0, 0xff1414, 0xff1414, 0xff1414, 0x4f4d4d, 0, 0, 0,        0x646464,
-        0, 0,        0,        0,        0,        0, 0, 0,        0,
-        0, 0,        0,        0,        0,        0,
-    },
-    {
-        0,        0,        0,        0, 0, 0, 0,        0,        0,        0,
-        0,        0,        0,        0, 0, 0, 0x646464, 0,        0,        0,
-        0xff1414, 0xff1414, 0x4f4d4d, 0, 0, 0, 0x4f4d4d, 0xff1414, 0xff1414, 0,
-        0,        0,        0,        0, 0, 0, 0,        0,        0,        0,
-        0,        0,
-    },
-    {
-        0,        0,        0,        0, 0, 0,        0,
-        0,        0,        0,        0, 0, 0,        0,
-        0,        0x646464, 0x646464, 0, 0, 0,        0xff1414,
-        0xff1414, 0x4f4d4d, 0,        0, 0, 0x4f4d4d, 0xff1414,
-        0xff1414, 0xff1414, 0,        0, 0, 0,        0,
-        0,        0,        0,        0, 0, 0,        0,
-    },
-    {
-        0, 0, 0, 0, 0,        0,        0, 0,        0,        0, 0,
-        0, 0, 0, 0, 0x4f4d4d, 0x646464, 0, 0,        0,        0, 0xff1414,
-        0, 0, 0, 0, 0xcb1a1a, 0xff1414, 0, 0xff1414, 0xcb1a1a, 0, 0,
-        0, 0, 0, 0, 0xff1414, 0,        0, 0,        0,
-    },
-    {
-        0,        0, 0, 0,        0, 0, 0,        0,        0,
-        0,        0, 0, 0x646464, 0, 0, 0x4f4d4d, 0x646464, 0,
-        0,        0, 0, 0xff1414, 0, 0, 0,        0,        0xcb1a1a,
-        0xff1414, 0, 0, 0xff1414, 0, 0, 0,        0,        0,
-        0xcb1a1a, 0, 0, 0,        0, 0,
-    },
-    {
-        0,        0, 0, 0,        0, 0, 0,        0,        0,
-        0,        0, 0, 0x646464, 0, 0, 0x4f4d4d, 0x646464, 0,
-        0,        0, 0, 0xff1414, 0, 0, 0,        0,        0xcb1a1a,
-        0xff1414, 0, 0, 0xff1414, 0, 0, 0,        0,        0,
-        0xff1414, 0, 0, 0xcb1a1a, 0, 0,
-    },
-    {
-        0,        0, 0,        0,        0,        0, 0, 0,        0,
-        0,        0, 0x4f4d4d, 0,        0,        0, 0, 0x646464, 0,
-        0,        0, 0x646464, 0xff1414, 0x4f4d4d, 0, 0, 0,        0xff1414,
-        0,        0, 0,        0xff1414, 0xcb1a1a, 0, 0, 0,        0,
-        0xff1414, 0, 0,        0xff1414, 0,        0,
-    },
-    {
-        0, 0, 0,        0,        0,        0, 0, 0,        0,
-        0, 0, 0x4f4d4d, 0,        0,        0, 0, 0x646464, 0,
-        0, 0, 0x646464, 0xff1414, 0x4f4d4d, 0, 0, 0,        0xff1414,
-        0, 0, 0,        0,        0xff1414, 0, 0, 0,        0xff1414,
-        0, 0, 0,        0,        0xff1414, 0,
-    },
-    {
-        0, 0, 0,        0,        0,        0,        0, 0,        0,
-        0, 0, 0x4f4d4d, 0,        0,        0,        0, 0x646464, 0,
-        0, 0, 0x646464, 0xff1414, 0x4f4d4d, 0,        0, 0,        0xff1414,
-        0, 0, 0,        0,        0xff1414, 0xcb1a1a, 0, 0xff1414, 0,
-        0, 0, 0,        0,        0,        0,
-    },
-    {
-        0, 0,        0, 0,        0, 0,        0, 0,        0,
-        0, 0x4f4d4d, 0, 0,        0, 0,        0, 0x646464, 0x646464,
-        0, 0,        0, 0xff1414, 0, 0,        0, 0xcb1a1a, 0xff1414,
-        0, 0,        0, 0,        0, 0xff1414, 0, 0xff1414, 0,
-        0, 0,        0, 0,        0, 0,
-    },
-    {
-        0, 0, 0, 0,        0, 0,        0,        0,        0,
-        0, 0, 0, 0,        0, 0,        0,        0x646464, 0x646464,
-        0, 0, 0, 0xff1414, 0, 0,        0,        0xcb1a1a, 0xff1414,
-        0, 0, 0, 0,        0, 0xff1414, 0xcb1a1a, 0,        0,
-        0, 0, 0, 0,        0, 0,
-    },
-    {
-        0, 0, 0,        0,        0,        0, 0,        0,        0,
-        0, 0, 0,        0,        0,        0, 0,        0x4f4d4d, 0x646464,
-        0, 0, 0x646464, 0xff1414, 0xcb1a1a, 0, 0xcb1a1a, 0xff1414, 0x4f4d4d,
-        0, 0, 0,        0,        0,        0, 0xff1414, 0,        0,
-        0, 0, 0,        0,        0,        0,
-    },
-    {
-        0, 0, 0,        0,        0,        0, 0,        0,        0,
-        0, 0, 0,        0,        0,        0, 0,        0x4f4d4d, 0,
-        0, 0, 0x646464, 0xff1414, 0xcb1a1a, 0, 0xff1414, 0xff1414, 0x4f4d4d,
-        0, 0, 0,        0,        0,        0, 0,        0,        0,
-        0, 0, 0,        0,        0,        0,
-    },
-    {
-        0, 0, 0,        0,        0,        0,        0, 0,        0,
-        0, 0, 0,        0,        0,        0,        0, 0x4f4d4d, 0,
-        0, 0, 0x646464, 0xff1414, 0xff1414, 0xbe1515, 0, 0,        0x4f4d4d,
-        0, 0, 0,        0,        0,        0,        0, 0,        0,
-        0, 0, 0,        0,        0,        0,
-    },
-    {
-        0,        0,        0,        0, 0,        0,        0,        0, 0, 0,
-        0,        0,        0,        0, 0xff1414, 0xff1414, 0x4f4d4d, 0, 0, 0,
-        0x646464, 0xff1414, 0xbe1515, 0, 0,        0,        0x4f4d4d, 0, 0, 0,
-        0,        0,        0,        0, 0,        0,        0,        0, 0, 0,
-        0,        0,
-    },
-    {
-        0,        0,        0,        0, 0, 0,        0,
-        0,        0,        0,        0, 0, 0,        0xff1414,
-        0xbe1515, 0xff1414, 0x4f4d4d, 0, 0, 0,        0x646464,
-        0xff1414, 0xbe1515, 0,        0, 0, 0x4f4d4d, 0x646464,
-        0,        0,        0,        0, 0, 0,        0,
-        0,        0,        0,        0, 0, 0,        0,
-    },
-    {
-        0, 0,        0,        0, 0xff1414, 0,        0, 0, 0, 0, 0,
-        0, 0xff1414, 0xbe1515, 0, 0xbe1515, 0xff1414, 0, 0, 0, 0, 0xff1414,
-        0, 0,        0,        0, 0x646464, 0x4f4d4d, 0, 0, 0, 0, 0,
-        0, 0,        0,        0, 0,        0,        0, 0, 0,
-    },
-    {
-        0, 0,        0, 0, 0xbe1515, 0xff1414, 0, 0, 0,        0, 0,
-        0, 0xff1414, 0, 0, 0xbe1515, 0xff1414, 0, 0, 0,        0, 0xff1414,
-        0, 0,        0, 0, 0x4f4d4d, 0x646464, 0, 0, 0x4f4d4d, 0, 0,
-        0, 0,        0, 0, 0,        0,        0, 0, 0,
-    },
-    {
-        0,        0,        0,        0xff1414, 0,        0xff1414, 0,
-        0,        0,        0,        0,        0xbe1515, 0xff1414, 0,
-        0,        0xbe1515, 0xff1414, 0,        0,        0,        0,
-        0xff1414, 0,        0,        0,        0,        0x4f4d4d, 0x646464,
-        0,        0,        0x4f4d4d, 0,        0,        0,        0,
-        0,        0,        0,        0,        0,        0,        0,
-    },
-    {
-        0, 0, 0,        0xff1414, 0,        0xff1414, 0, 0,        0,
-        0, 0, 0xff1414, 0xcb1a1a, 0,        0,        0, 0xff1414, 0,
-        0, 0, 0x646464, 0xff1414, 0x4f4d4d, 0,        0, 0,        0x646464,
-        0, 0, 0,        0,        0x4f4d4d, 0,        0, 0,        0,
-        0, 0, 0,        0,        0,        0,
-    },
-    {
-        0xcb1a1a, 0,        0xff1414, 0, 0, 0, 0xff1414, 0, 0, 0,
-        0,        0xff1414, 0,        0, 0, 0, 0xff1414, 0, 0, 0,
-        0x646464, 0xff1414, 0x4f4d4d, 0, 0, 0, 0x646464, 0, 0, 0,
-        0,        0x4f4d4d, 0,        0, 0, 0, 0,        0, 0, 0,
-        0,        0,
-    },
-    {
-        0, 0xff1414, 0,        0,        0,        0, 0, 0xff1414, 0,
-        0, 0xff1414, 0xcb1a1a, 0,        0,        0, 0, 0xff1414, 0,
-        0, 0,        0x646464, 0xff1414, 0x4f4d4d, 0, 0, 0,        0x646464,
-        0, 0,        0,        0,        0x4f4d4d, 0, 0, 0,        0,
-        0, 0,        0,        0,        0,        0,
-    },
-    {
-        0, 0xff1414, 0, 0,        0, 0,        0, 0xff1414, 0,
-        0, 0xff1414, 0, 0,        0, 0,        0, 0xcb1a1a, 0xff1414,
-        0, 0,        0, 0xff1414, 0, 0,        0, 0x4f4d4d, 0x646464,
-        0, 0,        0, 0,        0, 0x646464, 0, 0,        0,
-        0, 0,        0, 0,        0, 0,
-    },
-    {
-        0, 0,        0, 0,        0, 0,        0, 0xcb1a1a, 0xff1414,
-        0, 0xff1414, 0, 0,        0, 0,        0, 0xcb1a1a, 0xff1414,
-        0, 0,        0, 0xff1414, 0, 0,        0, 0x4f4d4d, 0x646464,
-        0, 0,        0, 0,        0, 0x646464, 0, 0,        0,
-        0, 0,        0, 0,        0, 0,
-    },
-    {
-        0,        0,        0, 0,        0, 0, 0, 0,        0xff1414,
-        0xff1414, 0xcb1a1a, 0, 0,        0, 0, 0, 0xcb1a1a, 0xff1414,
-        0,        0,        0, 0xff1414, 0, 0, 0, 0x4f4d4d, 0x646464,
-        0,        0,        0, 0,        0, 0, 0, 0,        0,
-        0,        0,        0, 0,        0, 0,
-    },
-    {
-        0,        0, 0,        0,        0,        0, 0, 0,        0,
-        0xff1414, 0, 0,        0,        0,        0, 0, 0x4f4d4d, 0xff1414,
-        0xff1414, 0, 0xff1414, 0xff1414, 0x4f4d4d, 0, 0, 0x646464, 0x646464,
-        0,        0, 0,        0,        0,        0, 0, 0,        0,
-        0,        0, 0,        0,        0,        0,
-    },
-    {
-        0,        0, 0,        0,        0,        0, 0, 0,        0,
-        0,        0, 0,        0,        0,        0, 0, 0x4f4d4d, 0xff1414,
-        0xff1414, 0, 0xff1414, 0xff1414, 0x4f4d4d, 0, 0, 0,        0x646464,
-        0,        0, 0,        0,        0,        0, 0, 0,        0,
-        0,        0, 0,        0,        0,        0,
-    },
+// 由 assets/extract_pixels.py 生成, 常量数据保存在flash中
+
+/// 调色板, 0号为黑色
+const uint32_t framePalette[6] = {
+    0x000000, 0xff1414, 0x4f4d4d, 0x646464, 0xcb1a1a, 0xbe1515,
+};
+
+/// 每帧42个像素, 每像素4位调色板索引, 低4位在前
+const uint8_t frames[27][21] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x10, 0x11, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x11, 0x02, 0x00, 0x12, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x03, 0x00, 0x11, 0x02, 0x00, 0x12, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x03, 0x00, 0x10, 0x00, 0x00, 0x14, 0x10, 0x04, 0x00, 0x00, 0x10, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x20, 0x03, 0x00, 0x10, 0x00, 0x00, 0x14, 0x00, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x20, 0x03, 0x00, 0x10, 0x00, 0x00, 0x14, 0x00, 0x01, 0x00, 0x00, 0x01, 0x40, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x03, 0x00, 0x13, 0x02, 0x00, 0x01, 0x00, 0x41, 0x00, 0x00, 0x01, 0x10, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x03, 0x00, 0x13, 0x02, 0x00, 0x01, 0x00, 0x10, 0x00, 0x10, 0x00, 0x00, 0x01},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x03, 0x00, 0x13, 0x02, 0x00, 0x01, 0x00, 0x10, 0x04, 0x01, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x33, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x32, 0x00, 0x13, 0x04, 0x14, 0x02, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x13, 0x04, 0x11, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x13, 0x51, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x02, 0x00, 0x13, 0x05, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x15, 0x02, 0x00, 0x13, 0x05, 0x00, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x51, 0x50, 0x01, 0x00, 0x10, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x01, 0x50, 0x01, 0x00, 0x10, 0x00, 0x00, 0x32, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x10, 0x10, 0x00, 0x00, 0x50, 0x01, 0x50, 0x01, 0x00, 0x10, 0x00, 0x00, 0x32, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x10, 0x10, 0x00, 0x00, 0x10, 0x04, 0x00, 0x01, 0x00, 0x13, 0x02, 0x00, 0x03, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x04, 0x01, 0x00, 0x01, 0x00, 0x10, 0x00, 0x00, 0x01, 0x00, 0x13, 0x02, 0x00, 0x03, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x10, 0x00, 0x00, 0x10, 0x00, 0x41, 0x00, 0x00, 0x01, 0x00, 0x13, 0x02, 0x00, 0x03, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x10, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00, 0x00, 0x14, 0x00, 0x10, 0x00, 0x20, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x40, 0x01, 0x01, 0x00, 0x00, 0x14, 0x00, 0x10, 0x00, 0x20, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x11, 0x04, 0x00, 0x00, 0x14, 0x00, 0x10, 0x00, 0x20, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x12, 0x01, 0x11, 0x02, 0x30, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x01, 0x11, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
+/// 每帧的指针像素掩码, 第i位对应第i个像素, 渲染时替换为指针颜色
+const uint64_t framePointerMasks[27] = {
+    0x00000380000ULL,
+    0x00018300000ULL,
+    0x00038300000ULL,
+    0x0206c200000ULL,
+    0x0104c200000ULL,
+    0x0904c200000ULL,
+    0x090c4200000ULL,
+    0x10884200000ULL,
+    0x00584200000ULL,
+    0x00506200000ULL,
+    0x00306200000ULL,
+    0x00203600000ULL,
+    0x00003600000ULL,
+    0x00000e00000ULL,
+    0x0000060c000ULL,
+    0x0000060e000ULL,
+    0x0000021b010ULL,
+    0x00000219030ULL,
+    0x00000219828ULL,
+    0x00000211828ULL,
+    0x00000210845ULL,
+    0x00000210c82ULL,
+    0x00000230482ULL,
+    0x00000230580ULL,
+    0x00000230700ULL,
+    0x00000360200ULL,
+    0x00000360000ULL,
 };
 
-float bootAnimationValues[] = {
+const float bootAnimationValues[] = {
     270.00, 313.33, 13.81,  74.03, 121.35, 149.26, 157.11, 148.67, 130.12,
     108.11, 88.23,  74.09,  67.13, 66.88,  71.59,  78.90,  86.59,  92.92,
     96.92,  98.38,  97.67,  95.54, 92.81,  90.23,  88.29,  87.24,  87.06,
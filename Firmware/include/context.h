@@ -3,9 +3,35 @@
 #include "IState.h"
 #include "common.h"
 #include <Arduino.h>
+#include <atomic>
+#include <mutex>
+
+// 状态转换记录的条数, 超出后覆盖最旧的记录
+#define STATE_TRACE_SIZE 16
 
 namespace mcompass {
 
+/// @brief 一次状态转换
+struct StateTransition {
+  uint32_t timestamp; // millis()
+  StateId from;
+  StateId to;
+  int8_t trigger; // 触发的 Event::Type, 直接调用 setState 时为-1
+};
+
+/// @brief 多个任务共享的上下文字段, 由 Context::snapshot 一次性读取
+struct ContextSnapshot {
+  Location currentLocation{};
+  // 默认目标位置设置为天安门经纬度（示例值）
+  Location spawnLocation{39.908692f, 116.397477f};
+  PointerColor color;
+  WorkType workType = WorkType::SOUTH;
+  Event::Source subscribeSource = Event::Source::SENSOR;
+  uint8_t brightness = DEFAULT_BRIGHTNESS;
+  bool gpsFixed = false;
+  State deviceState = State::COMPASS;
+};
+
 /// @brief 上下文
 class Context {
 public:
@@ -60,60 +86,102 @@ public:
   uint8_t getBrightness() const;
   void setBrightness(uint8_t bright);
 
+  /// Web/BLE任务会改写, 加锁复制一份返回
   String getSsid() const;
   void setSsid(const String &id);
 
+  /// Web/BLE任务会改写, 加锁复制一份返回
   String getPassword() const;
   void setPassword(const String &pass);
 
   Event::Source getSubscribeSource() const;
   void setSubscribeSource(Event::Source src);
 
-  int getAzimuth() const;
-  void setAzimuth(int azi);
+  angle::Centideg getAzimuth() const;
+  void setAzimuth(angle::Centideg azi);
 
-  int getLastAzimuth() const;
-  void setLastAzimuth(int azi);
+  angle::Centideg getLastAzimuth() const;
+  void setLastAzimuth(angle::Centideg azi);
 
+  /**
+   * @brief 事件循环
+   */
   esp_event_loop_handle_t getEventLoop();
 
   void setEventLoop(esp_event_loop_handle_t loop);
 
+  /**
+   * @brief 投递控制事件. 队列满时最多等待 CONTROL_EVENT_TIMEOUT_MS,
+   * 仍然满则丢弃并计为超时, 只记录日志, 不会长时间阻塞调用方(BLE, 定时器任务).
+   * 方位角等流式数据不经过这里, 由生产者写入 mailbox, 新值覆盖旧值
+   */
+  esp_err_t postEvent(const Event::Body &event);
+
   void logSelf(char *buffer);
 
+  /**
+   * @brief 一次读取位置, 目标位置, 颜色, 工作模式, 订阅源, 亮度等共享字段.
+   * 不加锁, 也不会读到写了一半的数据; 写入方正在写时读到的是上一次发布的值
+   */
+  ContextSnapshot snapshot() const;
+
   void setIsGPSFixed(bool isFixed);
   bool getIsGPSFixed() const;
 
-  void setState(IState *newState);
+  /**
+   * @brief 切换到指定状态, 依次调用旧状态的 onExit 和新状态的 onEnter
+   * @param trigger 触发的事件类型, 直接调用时为-1
+   */
+  void setState(StateId id, int8_t trigger = -1);
+
+  StateId getStateId() const;
 
   IState *getCurrentState();
 
+  /**
+   * @brief 输出最近的状态转换记录, 从旧到新, 每条形如
+   * "时间戳:旧状态->新状态(事件)", 以分号分隔
+   */
+  void logTransitions(char *buffer, size_t size);
+
+  /**
+   * @brief 先查状态转换表, 有对应的转换则切换状态, 否则把事件交给当前状态处理.
+   * 在事件循环任务中调用
+   */
+  void handleEvent(Event::Body *evt);
+
 private:
   // 私有构造函数，确保外部不能直接创建对象
   Context() = default;
   ~Context() = default;
+  /**
+   * @brief 修改共享字段: 在另一份缓冲上修改后切换版本号, 写入方之间用互斥锁串行
+   */
+  template <typename Fn> void publish(Fn update);
+  /**
+   * @brief 读取单个共享字段
+   */
+  template <typename T> T readShared(T ContextSnapshot::*field) const;
+
   // 内部变量定义
   Model model;
-  State deviceState = State::COMPASS;
   State lastDeviceState = State::STARTING;
-  // 根据 model 判断默认的工作类型
-  WorkType workType = (model == Model::GPS ? WorkType::SPAWN : WorkType::SOUTH);
   bool detectGPS = false;
   bool hasSensor = true;
-  PointerColor color;  // 默认构造，具体初值请根据需求设置
-  Location currentLoc; // 当前位置，初值默认构造
-  // 默认目标位置设置为天安门经纬度（示例值）
-  Location spawnLocation{39.908692f, 116.397477f};
   ServerMode serverMode = DEFAULT_SERVER_MODE;
   SensorModel sensorModel = SensorModel::QMC5883L; // 传感器型号
-  uint8_t brightness = DEFAULT_BRIGHTNESS;
   String ssid = "";
   String password = "";
-  Event::Source subscribeSource = Event::Source::SENSOR;
-  int azimuth = 0;
-  int lastAzimuth = 0;
-  volatile bool isGPSFixed = false;
-  IState *m_currentState = nullptr;
+  angle::Centideg azimuth = 0; // 0.01度
+  angle::Centideg lastAzimuth = 0;
+  // 共享字段双缓冲: 当前版本在 m_shared[m_version & 1]
+  ContextSnapshot m_shared[2];
+  std::atomic<uint32_t> m_version{0};
+  // 串行化共享字段的写入, 也保护 ssid 和 password
+  mutable std::mutex m_writeMutex;
+  StateId m_stateId = StateId::COUNT;
+  StateTransition m_trace[STATE_TRACE_SIZE] = {};
+  uint32_t m_traceCount = 0;
   esp_event_loop_handle_t eventLoop;
 };
 } // namespace mcompass
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <esp_event.h>
 #include <stdint.h>
 
+#include "angle_def.h"
+
 ESP_EVENT_DECLARE_BASE(MCOMPASS_EVENT);
 
 namespace Event {
@@ -15,6 +17,7 @@ enum class Type {
   BUTTON_MULTI_CLICK,  // 多次点击
   SENSOR_CALIBRATE,    // 传感器校准
   FACTORY_RESET,       // 恢复出厂设置
+  CALIBRATION_DONE,    // 校准结束(结果已应用或超时)
 };
 
 // 消息源
@@ -34,7 +37,7 @@ struct Body {
   Source source;  // 消息源头
   union {
     struct {  // 方位角
-      int angle;
+      mcompass::angle::Centideg angle;  // 0.01度
     } azimuth;
     struct {  // 文字
       char text[64];
@@ -0,0 +1,94 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "macro_def.h"
+
+/**
+ * 方位角到帧索引的查找表, 编译期生成, 每0.1度一项, 共3600字节, 放在flash中.
+ * 每项低5位为帧索引; 距离上一帧/下一帧的边界不到 FRAME_HYSTERESIS_DECIDEG 时
+ * 分别置位 kNearPrev/kNearNext, 查表时据此保持刚越过边界前显示的帧, 边界处不闪烁.
+ * 只兼容 C++11 的 constexpr, 函数体都是单个 return 表达式.
+ */
+namespace mcompass {
+namespace frame_lut {
+
+constexpr size_t kEntries = 3600;
+constexpr uint8_t kIndexMask = 0x1F;
+constexpr uint8_t kNearPrev = 0x40;
+constexpr uint8_t kNearNext = 0x80;
+
+static_assert(MAX_FRAME_INDEX <= kIndexMask, "frame index needs more bits");
+// 最窄的帧占 90/7 度, 回差超过一半时两侧的标记会重叠
+static_assert(FRAME_HYSTERESIS_DECIDEG >= 0 && FRAME_HYSTERESIS_DECIDEG < 64,
+              "FRAME_HYSTERESIS_DECIDEG must be below half the narrowest frame");
+
+/**
+ * 原始素材中指针的方位角不是均匀分布的
+ * 去除高度重复帧后, 得到27帧不同的图像, 其中第N张图像对应
+ * 1 正上
+ * 8 正右
+ * 14 正下
+ * 21 正右
+ * 以0.01度为单位的整数运算, 较小的间距为 9000/7, 90°~180°的间距为 9000/6
+ */
+constexpr int frameOf(int32_t azimuth) {
+  return azimuth * 7 < 9000 * 6    ? azimuth * 7 / 9000
+         : azimuth * 6 < 9000 * 11 ? 7 + (azimuth - 9000) * 6 / 9000
+         : (azimuth - 18000) * 7 < 9000 * 6
+             ? 13 + (azimuth - 18000) * 7 / 9000
+             : (20 + (azimuth - 27000) * 7 / 9000 < MAX_FRAME_INDEX
+                    ? 20 + (azimuth - 27000) * 7 / 9000
+                    : MAX_FRAME_INDEX);
+}
+
+/// 第 tenth 个0.1度区间中点所在的帧, tenth 可以超出一圈
+constexpr int frameOfTenth(int32_t tenth) {
+  return frameOf(((tenth % (int32_t)kEntries + (int32_t)kEntries) %
+                  (int32_t)kEntries) *
+                     10 +
+                 5);
+}
+
+constexpr uint8_t entryOf(int32_t tenth) {
+  return (uint8_t)(frameOfTenth(tenth) |
+                   (frameOfTenth(tenth - FRAME_HYSTERESIS_DECIDEG) !=
+                            frameOfTenth(tenth)
+                        ? kNearPrev
+                        : 0) |
+                   (frameOfTenth(tenth + FRAME_HYSTERESIS_DECIDEG) !=
+                            frameOfTenth(tenth)
+                        ? kNearNext
+                        : 0));
+}
+
+// C++11 没有 std::index_sequence, 按对半拼接生成, 模板递归深度只有 log2(N)
+template <size_t... I> struct Indices {};
+template <typename A, typename B> struct Concat;
+template <size_t... A, size_t... B>
+struct Concat<Indices<A...>, Indices<B...>> {
+  typedef Indices<A..., (sizeof...(A) + B)...> type;
+};
+template <size_t N> struct MakeIndices {
+  typedef typename Concat<typename MakeIndices<N / 2>::type,
+                          typename MakeIndices<N - N / 2>::type>::type type;
+};
+template <> struct MakeIndices<0> {
+  typedef Indices<> type;
+};
+template <> struct MakeIndices<1> {
+  typedef Indices<0> type;
+};
+
+struct Table {
+  uint8_t entries[kEntries];
+};
+
+template <size_t... I> constexpr Table makeTable(Indices<I...>) {
+  return {{entryOf((int32_t)I)...}};
+}
+
+constexpr Table build() { return makeTable(MakeIndices<kEntries>::type()); }
+
+} // namespace frame_lut
+} // namespace mcompass
@@ -25,5 +25,11 @@ bool isValidGPSLocation(Location location);
  * @brief GPS 关闭
  */
 void disable();
+
+/**
+ * @brief 把一行NMEA数据送入解析器, 用于回放记录的数据
+ * @return 解析器未初始化或已关闭时返回false
+ */
+bool feed(const char *line, size_t len);
 } // namespace gps
 } // namespace mcompass
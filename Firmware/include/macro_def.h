@@ -3,6 +3,8 @@
 ///////////////////// 宏定义 ///////////////////////
 #define NUM_LEDS 42
 #define MAX_FRAME_INDEX 26
+// 方位角越过帧边界超过该值(0.1度)才切换到相邻的帧, 见 frame_lut.h
+#define FRAME_HYSTERESIS_DECIDEG 10
 #define TIME_ZONE (+8)   // Beijing Time
 #define YEAR_BASE (2000) // date in GPS starts from 2000
 ///////////////////// 引脚定义 ///////////////////////
@@ -31,6 +33,66 @@
 // 默认检测不到GPS,关闭GPS供电时间
 #define DEFAULT_GPS_DETECT_TIMEOUT 30
 
+// 控制事件队列长度与队列满时的最长等待时间, 超时后丢弃该事件
+#define CONTROL_EVENT_QUEUE_SIZE 16
+#define CONTROL_EVENT_TIMEOUT_MS 10
+
+// 默认渲染帧率
+#define DEFAULT_RENDER_FPS 60
+
+// 采样任务查询数据就绪位的周期, 比传感器 200Hz 的输出周期短, 保证不漏采样
+#define SENSOR_POLL_MS 4
+// 传感器定时器(方位角计算)的周期, 约60Hz
+#define SENSOR_TICK_US 16667
+// 原始采样环形缓冲长度, 必须是2的幂
+#define SENSOR_RING_SIZE 16
+// 相邻采样间隔超过该值(微秒)且超过两个查询周期时重置抽取滤波器
+#define SENSOR_FILTER_RESET_US 100000
+// 探测传感器时每次I2C事务的超时, 与探测的轮数(轮与轮之间不等待)
+#define SENSOR_PROBE_TIMEOUT_MS 5
+#define SENSOR_PROBE_RETRY 3
+
+// 指针弹簧: 刚度与阻尼, 默认取临界阻尼 c = 2√k ≈ 15.5, 不超调;
+// 跟随匀速转动的滞后为 c/k ≈ 0.26秒. 阻尼必须大于0, 不超过 SPRING_DAMPING_MAX
+#define SPRING_STIFFNESS 60.0f
+#define SPRING_DAMPING 15.5f
+#define SPRING_STIFFNESS_MIN 1.0f
+#define SPRING_STIFFNESS_MAX 10000.0f
+#define SPRING_DAMPING_MAX 200.0f
+
+// /mathBench 默认的运行次数与上限, 在Web任务中同步运行
+#define MATH_BENCH_ITERATIONS 1000
+#define MATH_BENCH_MAX_ITERATIONS 10000
+
+// 运动检测: 最近 MOTION_WINDOW 个原始采样的三轴方差之和(原始读数的平方)
+// 超过 MOTION_MOVE_THRESHOLD 时立即恢复全速, 低于 MOTION_STILL_THRESHOLD
+// 持续 MOTION_STILL_MS 后降到 MOTION_IDLE_HZ 采样和渲染
+#define MOTION_WINDOW 8
+#define MOTION_MOVE_THRESHOLD 400
+#define MOTION_STILL_THRESHOLD 100
+#define MOTION_STILL_MS 5000
+#define MOTION_IDLE_HZ 4
+
+// 在线校准: 与上一个采纳的采样的距离(相对磁场幅值)小于该值时不采纳,
+// 避免静止时同一个方向占满权重
+#define CALIBRATOR_MIN_STEP 0.03
+// 遗忘窗口(采纳的采样数), 更早的采样按指数衰减
+#define CALIBRATOR_WINDOW 600
+// 求解需要的最少加权采样数
+#define CALIBRATOR_MIN_SAMPLES 100
+// 后台求解周期
+#define CALIBRATOR_SOLVE_MS 2000
+// 可以应用的最低质量分
+#define CALIBRATOR_MIN_QUALITY 0.6f
+// 两次保存之间的最短间隔, 质量分明显提高时不受限制
+#define CALIBRATOR_SAVE_INTERVAL_MS 600000
+// 校准状态: 开始前的倒计时, 超时后放弃本次校准
+#define CALIBRATE_COUNTDOWN_MS 3000
+#define CALIBRATE_TIMEOUT_MS 60000
+// 校准状态滚动文字每移动一列的间隔
+#define CALIBRATE_SCROLL_MS 100
+#define CALIBRATE_TEXT "calibrate"
+
 // 默认初始的坐标值
 #define DEFAULT_INVALID_LOCATION_VALUE 255.0f
 
@@ -79,6 +141,10 @@
   (uint16_t)(BASE_SERVICE_UUID + 8) // 服务器模式
 #define CUSTOM_MODEL_CHARACTERISTIC_UUID                                       \
   (uint16_t)(BASE_SERVICE_UUID + 9) // 自定义型号
+#define METRICS_CHARACTERISTIC_UUID                                            \
+  (uint16_t)(BASE_SERVICE_UUID + 10) // 运行统计, 只读
+#define EVENT_METRICS_CHARACTERISTIC_UUID                                      \
+  (uint16_t)(BASE_SERVICE_UUID + 11) // 事件队列统计, 只读
 
 /** 高级配置  */
 #define ADVANCED_SERVICE_UUID (uint16_t)0xfa00
@@ -100,6 +166,9 @@
 #define BRIGHTNESS_KEY "brightness"       // 亮度
 #define MODEL_KEY "model_key"             // 型号
 #define CALIBRATION_KEY "calibration_key" // 校准数据
+#define SENSOR_KEY "sensor_key"           // 上次探测到的传感器型号与地址
+#define MOTION_KEY "motion_key"           // 运动检测的阈值
+#define SPRING_KEY "spring_key"           // 指针弹簧的刚度与阻尼
 
 ///////////////////// 错误信息 ///////////////////////
 #define SENSOR_ERROR "Sensor Error 100"           // 传感器错误
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdint.h>
+
+#include "event.h"
+
+/**
+ * 方位角邮箱: 每个 Event::Source 一个只保留最新值的槽位.
+ * 生产者(传感器定时器, NETHER定时器, Web/BLE回调)直接覆盖槽位, 不经过事件队列;
+ * 渲染任务每帧读取一次最新值, 过期的采样直接被覆盖掉.
+ * 槽位是一个32位原子量, 高16位为序号, 低16位为方位角(0.01度), 读写都不加锁.
+ */
+namespace mcompass {
+namespace mailbox {
+
+/**
+ * @brief 写入 source 的最新方位角, 超出[0, 36000)的值先归一化
+ */
+void publish(Event::Source source, angle::Centideg angle);
+
+/**
+ * @brief 读取 source 的最新方位角
+ * @param seq 可选, 输出该值的序号, 每次 publish 递增, 用于判断是否有新值
+ * @return 从未写入过返回false
+ */
+bool read(Event::Source source, angle::Centideg &angle,
+          uint16_t *seq = nullptr);
+
+} // namespace mailbox
+} // namespace mcompass
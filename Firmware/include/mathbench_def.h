@@ -0,0 +1,39 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * 定点化前后的方位角和弹簧运算对照. 浮点实现保留为定点化之前的版本,
+ * 设备上经 /mathBench 运行, 主机上由 mcompass_bench 运行, 用同一份代码比较周期数.
+ */
+namespace mcompass {
+namespace mathbench {
+
+/**
+ * @brief 定点化之前的浮点校准与方位角计算
+ * @return 方位角, 单位0.01度, 范围[0, 36000)
+ */
+int32_t headingFloat(int x, int y);
+
+/**
+ * @brief 与 headingFloat 相同校准参数的定点实现, 同 Magnetometer::getAzimuthCentideg
+ */
+int32_t headingFixed(int x, int y);
+
+/**
+ * @brief 定点化之前的浮点弹簧插值(60Hz固定步长的欧拉积分)
+ * @param target 目标方位角(度)
+ * @return 插值后的方位角(度)
+ */
+float springFloat(float target);
+
+/**
+ * @brief 在当前CPU上各运行 iterations 次浮点与定点实现, 以JSON输出单次平均周期数
+ * {"iterations":N,"heading":[浮点,定点],"spring":[浮点,定点]}.
+ * 定点弹簧推进独立的状态, 不影响正在显示的指针
+ * @return 写入的字符数(不含结尾'\0'), 缓冲区不足时返回0
+ */
+size_t toJson(char *buffer, size_t size, int iterations);
+
+} // namespace mathbench
+} // namespace mcompass
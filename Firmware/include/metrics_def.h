@@ -0,0 +1,121 @@
+#pragma once
+#include <esp_cpu.h>
+#include <esp_event.h>
+#include <esp_idf_version.h>
+#include <freertos/FreeRTOS.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event.h"
+
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+// IDF 4.x 中的名字
+#define esp_cpu_get_cycle_count esp_cpu_get_ccount
+#endif
+
+// toJson/eventsToJson 的缓冲区大小, 按所有数值都是10位数的最坏情况计算
+// (分别为600和702字节, 含结尾'\0'). BLE属性最长512字节, 放不下的条目被省略
+#define METRICS_JSON_SIZE 768
+
+namespace mcompass {
+namespace metrics {
+
+/// 传感器到LED的处理阶段
+enum class Stage : uint8_t {
+  I2C_READ,     // 传感器I2C读取
+  HEADING_MATH, // 校准与方位角计算
+  SPRING,       // 弹簧插值
+  EVENT_POST,   // esp_event_post_to
+  DISPATCH,     // 事件分发到当前状态
+  FRAME_LOOKUP, // 帧数据查找与着色
+  LED_TRANSMIT, // FastLED.show()
+  RENDER,       // 渲染任务的一帧, 含帧查找与LED输出
+  COUNT,
+};
+
+/// 启动过程中的时间点
+enum class BootMark : uint8_t {
+  BOARD_INIT,    // 进入 board::init
+  SENSOR_PROBED, // 传感器型号探测完成
+  SENSOR_READY,  // 传感器驱动与采样任务就绪
+  SERVER_READY,  // BLE/Web服务器初始化完成
+  FIRST_FRAME,   // 第一帧写入LED
+  COUNT,
+};
+
+/**
+ * @brief 当前CPU周期计数, 用作 record 的起点
+ */
+static inline uint32_t now() { return esp_cpu_get_cycle_count(); }
+
+/**
+ * @brief 记录一次阶段耗时
+ * @param stage 阶段
+ * @param startCycles 阶段开始时 now() 的返回值
+ */
+void record(Stage stage, uint32_t startCycles);
+
+/**
+ * @brief 投递事件到事件循环, 并按来源统计投递/丢弃/超时次数和队列深度
+ * @param ticksToWait 队列满时的等待时间, 0 表示不等待, 失败计为丢弃;
+ * 非0时失败计为超时
+ * @return esp_event_post_to 的返回值
+ */
+esp_err_t postEvent(esp_event_loop_handle_t loop, const Event::Body &event,
+                    TickType_t ticksToWait);
+
+/**
+ * @brief 记录一次事件分发完成, 同时计入 Stage::DISPATCH 和按类型的分发耗时
+ * @param startCycles 分发开始时 now() 的返回值
+ */
+void dispatched(const Event::Body &event, uint32_t startCycles);
+
+/**
+ * @brief 记录渲染任务的一帧, 同时计入 Stage::RENDER
+ * @param written 本帧是否写入了LED, 画面未变化时为false
+ * @param startCycles 帧开始时 now() 的返回值
+ * @param budgetCycles 帧预算, 超出时计为超时帧
+ */
+void recordFrame(bool written, uint32_t startCycles, uint32_t budgetCycles);
+
+/**
+ * @brief 记录一次LED输出请求
+ * @param sent 是否调用了 FastLED.show(), LED缓冲和亮度与上次相同时为false
+ */
+void recordTransmit(bool sent);
+
+/**
+ * @brief 记录启动时间点(自开机的微秒数), 每个时间点只记录第一次.
+ * FIRST_FRAME 由 recordFrame 在第一次写入LED时记录, 并打印开机到第一帧的耗时
+ */
+void bootMark(BootMark mark);
+
+/**
+ * @brief 以JSON输出各启动时间点的毫秒数, 未到达的时间点为-1
+ * @return 写入的字符数(不含结尾'\0'), 缓冲区不足时返回0
+ */
+size_t bootToJson(char *buffer, size_t size);
+
+/**
+ * @brief 清空所有统计, 不包括启动时间点
+ */
+void reset();
+
+/**
+ * @brief 以JSON输出各阶段的 [次数, 最小, 平均, p99, 最大] 周期数,
+ * 渲染帧的 [写入, 跳过, 超时] 帧数, 以及LED输出的 [发送, 跳过] 次数.
+ * 缓冲区不足时省略放不下的阶段, 输出仍是完整的JSON
+ * @return 写入的字符数(不含结尾'\0'), 连开头和结尾都放不下时返回0
+ */
+size_t toJson(char *buffer, size_t size);
+
+/**
+ * @brief 以JSON输出事件队列统计: 当前深度和历史最高深度,
+ * 各来源的 [投递, 丢弃, 超时] 次数, 各类型的 [次数, 平均, 最大] 分发周期数.
+ * 没有数据的来源和类型不输出, 缓冲区不足时省略放不下的来源和类型
+ * @return 写入的字符数(不含结尾'\0'), 连开头和结尾都放不下时返回0
+ */
+size_t eventsToJson(char *buffer, size_t size);
+
+} // namespace metrics
+} // namespace mcompass
@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * 运动检测: 采样完成时每个原始采样都送入 feed, 计算最近几个采样的三轴方差.
+ * 方差持续低于静止阈值时判为静止, 传感器降低输出数据率,
+ * 采样任务, 传感器定时器和渲染任务都降到 idleHz; 方差超过运动阈值时
+ * 在同一个采样内恢复全速.
+ */
+namespace mcompass {
+namespace motion {
+
+/// 判定策略, 保存在 preference 中
+struct Policy {
+  uint32_t moveThreshold;  // 方差之和超过该值判为运动
+  uint32_t stillThreshold; // 方差之和低于该值持续 stillMs 判为静止
+  uint32_t stillMs;
+  uint8_t idleHz; // 静止时的采样与渲染频率
+};
+
+struct Stats {
+  uint32_t idles;    // 进入静止的次数
+  uint32_t wakes;    // 从静止恢复的次数
+  uint32_t variance; // 最近一次计算的方差之和
+};
+
+/**
+ * @brief 默认策略, 见 macro_def.h 的 MOTION_*
+ */
+Policy defaultPolicy();
+
+/**
+ * @brief 设置策略, 不合法的字段保持不变
+ */
+void setPolicy(const Policy &policy);
+
+Policy getPolicy();
+
+/**
+ * @brief 清空采样窗口, 回到运动状态
+ */
+void reset();
+
+/**
+ * @brief 送入一个原始采样, 只能在一个任务中调用(采样完成回调)
+ * @param timestamp 采样时间, 微秒
+ * @return 静止/运动状态是否发生了变化
+ */
+bool feed(const int16_t xyz[3], int64_t timestamp);
+
+/**
+ * @brief 当前是否静止
+ */
+bool isStationary();
+
+Stats stats();
+
+} // namespace motion
+} // namespace mcompass
@@ -137,6 +137,12 @@ typedef struct {
  */
 typedef void *nmea_parser_handle_t;
 
+/**
+ * @brief Raw NMEA line callback, line is NUL terminated and includes "\r\n"
+ *
+ */
+typedef void (*nmea_parser_line_cb_t)(const char *line, size_t len);
+
 /**
  * @brief Default configuration for NMEA Parser
  *
@@ -205,6 +211,26 @@ esp_err_t nmea_parser_add_handler(nmea_parser_handle_t nmea_hdl, esp_event_handl
  */
 esp_err_t nmea_parser_remove_handler(nmea_parser_handle_t nmea_hdl, esp_event_handler_t event_handler);
 
+/**
+ * @brief Set a callback which receives every raw line read from UART
+ *
+ * @param nmea_hdl handle of NMEA parser
+ * @param line_cb callback, NULL to disable
+ */
+void nmea_parser_set_line_callback(nmea_parser_handle_t nmea_hdl, nmea_parser_line_cb_t line_cb);
+
+/**
+ * @brief Decode one NMEA line as if it was read from UART, then drive the event loop
+ *
+ * @param nmea_hdl handle of NMEA parser
+ * @param line NMEA statement, the trailing "\r\n" is optional
+ * @param len length of line
+ * @return esp_err_t
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_SIZE: Line does not fit into the runtime buffer
+ */
+esp_err_t nmea_parser_feed(nmea_parser_handle_t nmea_hdl, const char *line, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
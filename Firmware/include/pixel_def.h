@@ -31,25 +31,40 @@ void theNether();
 void showFrame(int index);
 /**
  * @brief 显示方位角
- * @param azimuth 方位角 范围应当是0~360
+ * @param azimuth 方位角, 单位0.01度, 范围应当是0~36000
  */
-void showByAzimuth(float azimuth);
+void showByAzimuth(angle::Centideg azimuth);
+/**
+ * @brief 方位角对应的帧索引, 查 frame_lut.h 的表
+ * @param azimuth 方位角, 单位0.01度, 范围应当是0~36000
+ * @param previous 当前显示的帧, 方位角越过与它的边界不到
+ * FRAME_HYSTERESIS_DECIDEG 时仍返回它; -1 表示不需要回差
+ * @return 帧索引, 方位角不合法时返回-1
+ */
+int indexByAzimuth(angle::Centideg azimuth, int previous = -1);
 /**
  * @brief 根据方位角显示帧
  * @param bearing 方位角
- * @param azimuth 当前罗盘方位角
+ * @param azimuth 当前罗盘方位角, 单位0.01度
  */
-void showFrameByBearing(float bearing, int azimuth);
+void showFrameByBearing(float bearing, angle::Centideg azimuth);
 /**
  * @brief 根据位置显示帧
  * @param latitudeA 目标位置纬度
  * @param longitudeA 目标位置经度
  * @param latitudeB 当前位置纬度
  * @param longitudeB 当前位置经度
- * @param azimuth 当前罗盘方位角
+ * @param azimuth 当前罗盘方位角, 单位0.01度
  */
 void showFrameByLocation(float latA, float lonA, float latB, float lonB,
-                         int azimuth);
+                         angle::Centideg azimuth);
+/**
+ * @brief 根据位置计算帧索引, 参数同 showFrameByLocation
+ * @param previous 当前显示的帧, 同 indexByAzimuth
+ * @return 帧索引, 计算结果不合法时返回-1
+ */
+int indexByLocation(float latA, float lonA, float latB, float lonB,
+                    angle::Centideg azimuth, int previous = -1);
 /**
  * @brief 热点
  */
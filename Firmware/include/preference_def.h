@@ -1,6 +1,8 @@
 #pragma once
 #include "common.h"
 #include "macro_def.h"
+#include "motion_def.h"
+#include "spring_def.h"
 
 namespace mcompass {
 
@@ -9,6 +11,17 @@ namespace preference {
 struct CalibrationData {
   float offsets[3];
   float scales[3];
+  // 在线椭球校准的软磁矩阵, 全为0时只使用 scales.
+  // 旧版本保存的数据只有前两项, 读取时其余字段为0
+  float matrix[3][3];
+  // 校准质量分 0~1, 按轴校准时为0
+  float quality;
+};
+
+/// 上次探测到的传感器, 下次启动时先按它确认
+struct SensorInfo {
+  SensorModel model;
+  uint8_t address;
 };
 
 /**
@@ -80,6 +93,36 @@ void setCalibration(CalibrationData data);
  */
 CalibrationData getCalibration();
 
+/**
+ * @brief 保存探测到的传感器
+ */
+void setSensorInfo(SensorInfo info);
+
+/**
+ * @brief 获取上次探测到的传感器, 没有保存过时型号为 UNKNOWN
+ */
+SensorInfo getSensorInfo();
+
+/**
+ * @brief 保存运动检测策略
+ */
+void setMotionPolicy(motion::Policy policy);
+
+/**
+ * @brief 获取运动检测策略, 没有保存过时为默认策略
+ */
+motion::Policy getMotionPolicy();
+
+/**
+ * @brief 保存指针弹簧参数
+ */
+void setSpringParams(spring::Params params);
+
+/**
+ * @brief 获取指针弹簧参数, 没有保存过时为默认参数
+ */
+spring::Params getSpringParams();
+
 /**
  * @brief 设置出厂设置
  */
@@ -0,0 +1,62 @@
+#pragma once
+#include "common.h"
+#include "macro_def.h"
+
+/**
+ * 渲染任务: 以固定帧率从方位角邮箱和上下文中采样当前方位角, 目标方位和指针颜色,
+ * 经弹簧插值计算出要显示的帧; 画面没有变化时不写LED. 事件循环只处理控制事件.
+ * 校准状态下改为绘制倒计时和校准进度动画.
+ * 罗盘状态下显示传感器方位角且设备静止时, 帧率降到运动检测策略的 idleHz.
+ */
+namespace mcompass {
+class Context;
+namespace render {
+
+/**
+ * @brief 创建渲染任务
+ * @param fps 帧率
+ */
+void init(Context *context, uint8_t fps = DEFAULT_RENDER_FPS);
+
+/**
+ * @brief 设置帧率, 下一帧生效
+ */
+void setFps(uint8_t fps);
+
+/**
+ * @brief 当前帧率, 静止时为降低后的帧率
+ */
+uint8_t getFps();
+
+/**
+ * @brief 恢复运动时唤醒渲染任务, 不等低帧率的帧周期结束
+ */
+void wake();
+
+/**
+ * @brief Web调试接口指定的画面: 全部LED显示 color.
+ * 由渲染任务在罗盘状态下的下一帧绘制, 数据源的画面变化时被覆盖;
+ * 渲染暂停期间的请求在重新开启时丢弃. 可以在任意任务中调用
+ */
+void showSolid(uint32_t color);
+
+/**
+ * @brief Web调试接口指定的画面: 以 color 为指针颜色显示第 index 帧,
+ * 指针颜色在之后的 MOD 模式画面中保留. 绘制时机同 showSolid
+ */
+void showFrame(int index, uint32_t color);
+
+/**
+ * @brief 开启/暂停渲染, 由罗盘和校准状态在进入/离开时调用,
+ * 其他状态自行绘制LED
+ */
+void setEnabled(bool enabled);
+
+/**
+ * @brief 渲染一帧, 渲染任务每个帧周期调用一次
+ * @return 本帧是否写入了LED
+ */
+bool frame();
+
+} // namespace render
+} // namespace mcompass
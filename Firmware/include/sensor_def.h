@@ -2,17 +2,67 @@
 #include "common.h"
 #include "macro_def.h"
 
+class I2CTransport;
+
 namespace mcompass {
 namespace sensor {
+
+/// @brief 一次原始采样
+struct RawSample {
+  int64_t timestamp; // esp_timer_get_time(), 微秒
+  int16_t xyz[3];    // 未校准的三轴读数
+};
+
+/// @brief 采样任务的统计
+struct SampleStats {
+  uint32_t samples;  // 写入环形缓冲的采样数
+  uint32_t overruns; // 缓冲满被丢弃的采样数
+  uint32_t notReady; // 查询时数据未就绪的次数
+  uint32_t odrRetries; // 输出数据率的写入没有排上队, 需要重试的次数
+};
+
+/**
+ * @brief 获取当前方位角: 环形缓冲中的全部采样依次送入CIC抽取滤波器,
+ * 用滤波输出计算. 没有新采样时返回上一次的结果. 不访问I2C
+ * @return 方位角, 单位0.01度
+ */
+angle::Centideg getAzimuth();
+
+/**
+ * @brief 经I2C传输层排队读取数据就绪位, 就绪时再突发读取6字节数据,
+ * 完成后写入环形缓冲. 请求提交后立即返回, 不等待总线.
+ * 提交前先应用运动检测的静止/运动变化(周期和传感器输出数据率).
+ * 由采样任务调用, 主机构建由定时器驱动
+ * @return 是否提交了请求, 上一次请求未完成时返回false
+ */
+bool sample();
+
+/**
+ * @brief 指定I2C传输层, 需在 init 之前调用; 主机构建用于注入模拟总线
+ */
+void setTransport(I2CTransport *transport);
+
+/**
+ * @brief 从环形缓冲取出一个采样, 只能在一个任务中调用
+ * @return 缓冲为空返回false
+ */
+bool pop(RawSample &out);
+
+/**
+ * @brief 采样任务的统计
+ */
+SampleStats stats();
+
 /**
- * @brief 校准罗盘
+ * @brief 采样任务当前的查询周期, 静止时降低, 见 motion_def.h
  */
-void calibrate();
+uint32_t getPollMs();
 
 /**
- * @brief 获取当前方位角
+ * @brief 传感器定时器回调: 计算方位角, 写入方位角邮箱
+ * @return 本次计算出的方位角, 单位0.01度
  */
-int getAzimuth();
+angle::Centideg tick();
 
 /**
  * @brief 传感器可用状态
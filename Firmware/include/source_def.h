@@ -0,0 +1,42 @@
+#pragma once
+#include <esp_timer.h>
+#include <stdint.h>
+
+#include "event.h"
+
+/**
+ * 数据源管理: 只运行能影响显示的方位角数据源.
+ * 各数据源的 esp_timer 由 attach 登记, 之后根据工作模式, 订阅源, GPS定位和设备状态
+ * 由 update 启动或停止. Context 中相关字段变化时会自动调用 update.
+ */
+namespace mcompass {
+namespace source {
+
+/**
+ * @brief 登记数据源的定时器, 定时器需已创建且未启动
+ * @param periodUs 定时周期
+ */
+void attach(Event::Source source, esp_timer_handle_t timer, uint64_t periodUs);
+
+/**
+ * @brief 修改数据源的定时周期, 正在运行时立即生效
+ */
+void setPeriod(Event::Source source, uint64_t periodUs);
+
+/**
+ * @brief 数据源的定时周期, 未登记时返回0
+ */
+uint64_t getPeriod(Event::Source source);
+
+/**
+ * @brief 数据源的定时器是否在运行
+ */
+bool isRunning(Event::Source source);
+
+/**
+ * @brief 根据上下文重新计算需要的数据源, 启动或停止对应的定时器
+ */
+void update();
+
+} // namespace source
+} // namespace mcompass
@@ -0,0 +1,74 @@
+#pragma once
+#include "common.h"
+#include "macro_def.h"
+
+/**
+ * 指针的弹簧阻尼动画: x'' = -k x - c x', x 为指针与目标的角度差.
+ * 按实际经过的时间用解析解推进, 与调用频率无关, 定时器延迟或降频时也不会发散.
+ * 渲染任务对所有数据源(SENSOR, NETHER, WEB_SERVER)使用同一个弹簧.
+ */
+namespace mcompass {
+namespace spring {
+
+/// 弹簧参数, 保存在 preference 中. 质量为1
+struct Params {
+  float stiffness; // 刚度 k (1/s²), 越大跟随越快
+  float damping;   // 阻尼 c (1/s), 等于 2√k 时为临界阻尼, 不超调
+};
+
+/**
+ * @brief 默认参数, 见 macro_def.h 的 SPRING_*
+ */
+Params defaultParams();
+
+/**
+ * @brief 设置参数, 超出 SPRING_STIFFNESS_MIN/MAX, 阻尼不大于0或超过 SPRING_DAMPING_MAX 时不修改
+ */
+void setParams(const Params &params);
+
+Params getParams();
+
+/// 指针状态. update 使用内部的一份, 基准测试等可以推进独立的一份
+struct State {
+  int32_t azimuth = 0;    // 位置, 1/256 个0.01度
+  int32_t velocity = 0;   // 速度, 每秒
+  int64_t residualUs = 0; // 不足1毫秒的时间
+};
+
+/**
+ * @brief 按经过的时间推进指针. 整数运算, 只有时间步长或参数变化时才用浮点计算系数
+ * @param target 目标方位角, 单位0.01度, 范围[0, 36000)
+ * @param elapsedUs 距上一次调用经过的时间, 微秒
+ * @return 插值后的方位角, 单位0.01度, 范围[0, 36000)
+ */
+angle::Centideg update(angle::Centideg target, int64_t elapsedUs);
+
+/**
+ * @brief 同 update, 推进给定的状态
+ */
+angle::Centideg update(State &state, angle::Centideg target,
+                       int64_t elapsedUs);
+
+/**
+ * @brief 指针是否已经停在 target 上, 此时 update 不会改变结果
+ */
+bool settled(angle::Centideg target);
+
+/**
+ * @brief 重置指针位置, 速度清零
+ * @param azimuth 指针位置, 单位0.01度
+ */
+void reset(angle::Centideg azimuth = 0);
+
+/**
+ * @brief 当前插值后的方位角, 单位0.01度
+ */
+angle::Centideg getAzimuth();
+
+/**
+ * @brief 当前指针角速度(度/秒)
+ */
+float getVelocity();
+
+} // namespace spring
+} // namespace mcompass
@@ -1,17 +1,19 @@
 #pragma once
 #include "IState.h"
+#include <esp_timer.h>
 
 using namespace mcompass;
 
 
 class CalibratingState : public IState {
 private:
-    uint32_t m_lastUpdate = 0;
-    int m_lastAzimuth = 0;
+    // 超时定时器, 到期后放弃本次校准
+    esp_timer_handle_t m_timeout = nullptr;
+    uint32_t m_enterTime = 0;
 
 public:
     virtual void onEnter(Context& context) override;
     virtual void onExit(Context& context) override;
     virtual void handleEvent(Context& context, Event::Body* evt) override;
-    virtual const char* getName() override { return "COMPASS"; }
-};
\ No newline at end of file
+    virtual const char* getName() override { return "CALIBRATING"; }
+};
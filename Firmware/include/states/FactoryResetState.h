@@ -13,5 +13,5 @@ public:
     virtual void onEnter(Context& context) override;
     virtual void onExit(Context& context) override;
     virtual void handleEvent(Context& context, Event::Body* evt) override;
-    virtual const char* getName() override { return "COMPASS"; }
+    virtual const char* getName() override { return "FACTORY_RESET"; }
 };
\ No newline at end of file
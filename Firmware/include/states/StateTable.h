@@ -0,0 +1,24 @@
+#pragma once
+#include "IState.h"
+
+namespace mcompass {
+namespace states {
+
+/**
+ * @brief 状态编号对应的静态实例, 编号无效时返回nullptr
+ */
+IState *get(StateId id);
+
+/**
+ * @brief 状态名称, 用于日志和转换记录
+ */
+const char *name(StateId id);
+
+/**
+ * @brief 在转换表中查找 (当前状态, 事件类型) 对应的目标状态
+ * @return 没有对应的转换时返回false, 事件交给当前状态处理
+ */
+bool findTransition(StateId from, Event::Type type, StateId &to);
+
+} // namespace states
+} // namespace mcompass
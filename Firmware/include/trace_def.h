@@ -0,0 +1,44 @@
+#pragma once
+#include "common.h"
+#include "macro_def.h"
+
+/**
+ * 传感器与GPS原始数据的记录格式, 每条记录一行, 从串口输出:
+ *
+ *   #S <时间戳us> <型号>           检测到的地磁传感器型号, 例如 QMC5883P
+ *   #M <时间戳us> <x> <y> <z>      地磁传感器适配器 read() 之后的三轴原始值
+ *   #N <时间戳us> <NMEA语句>       送入 gps_decode 的一行NMEA数据(不含\r\n)
+ *
+ * 其他行(例如日志)在回放时会被忽略, 因此可以直接保存串口监视器的输出.
+ * 编译时定义 ENABLE_TRACE 则默认开启记录.
+ */
+namespace mcompass {
+namespace trace {
+
+/**
+ * @brief 开启/关闭记录
+ */
+void setEnabled(bool enabled);
+
+/**
+ * @brief 记录是否开启
+ */
+bool isEnabled();
+
+/**
+ * @brief 记录地磁传感器型号, 回放时据此选择轴向换算
+ */
+void recordSensorModel(SensorModel model);
+
+/**
+ * @brief 记录一次地磁传感器原始读数
+ */
+void recordMagnetometer(int x, int y, int z);
+
+/**
+ * @brief 记录一行NMEA数据, 末尾的\r\n会被去掉
+ */
+void recordNmea(const char *line, size_t len);
+
+} // namespace trace
+} // namespace mcompass
@@ -0,0 +1,62 @@
+#include "FixedMath.h"
+
+namespace {
+
+const int kCordicIterations = 16;
+// 内部角度单位: 1/256 个0.01度, 减小逐次累加的舍入误差
+const int kAngleFracBits = 8;
+// atan(2^-i), 单位同上
+const int32_t kAtanTable[kCordicIterations] = {
+    1152000, 680065, 359328, 182400, 91554, 45822, 22916, 11459,
+    5730,    2865,   1432,   716,    358,   179,   90,    45,
+};
+// 归一化后较大分量落在 [2^28, 2^29), 迭代增益约1.65, 不会溢出 int32
+const int kNormalizedBits = 29;
+
+int bitLength(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+} // namespace
+
+int32_t fixed::atan2Centideg(int64_t y, int64_t x) {
+    if (x == 0 && y == 0) return 0;
+
+    // 旋转到右半平面, 结果再加回180度
+    int32_t angle = 0;
+    if (x < 0) {
+        x = -x;
+        y = -y;
+        angle = (kTurnCentideg / 2) << kAngleFracBits;
+    }
+
+    uint64_t magnitude = (uint64_t)x | (uint64_t)(y < 0 ? -y : y);
+    int shift = bitLength(magnitude) - kNormalizedBits;
+    int32_t xi, yi;
+    if (shift > 0) {
+        xi = (int32_t)(x >> shift);
+        yi = (int32_t)(y >> shift);
+    } else {
+        xi = (int32_t)(x << -shift);
+        yi = (int32_t)(y << -shift);
+    }
+
+    // 每一步把向量朝x轴旋转 atan(2^-i), 累加转过的角度
+    for (int i = 0; i < kCordicIterations; i++) {
+        int32_t xNext;
+        if (yi > 0) {
+            xNext = xi + (yi >> i);
+            yi -= xi >> i;
+            angle += kAtanTable[i];
+        } else {
+            xNext = xi - (yi >> i);
+            yi += xi >> i;
+            angle -= kAtanTable[i];
+        }
+        xi = xNext;
+    }
+
+    int32_t centideg = (angle + (1 << (kAngleFracBits - 1))) >> kAngleFracBits;
+    if (centideg > kTurnCentideg / 2) centideg -= kTurnCentideg;
+    return centideg;
+}
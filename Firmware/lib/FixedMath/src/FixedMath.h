@@ -0,0 +1,56 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <stdint.h>
+
+// 定点数运算. ESP32-C3 没有硬件浮点单元, 浮点运算都是软件模拟,
+// 方位角和弹簧插值这类每秒几十上百次的计算改用整数完成.
+// 角度统一用0.01度(centidegree)表示.
+namespace fixed {
+
+// Qm.n 定点数: 整数存储 value * 2^n
+typedef int32_t q16_t; // 16位小数, 弹簧状态等
+typedef int32_t q24_t; // 24位小数, 远小于1的系数, 例如校准比例
+
+// 一周, 单位0.01度
+const int32_t kTurnCentideg = 36000;
+
+// 浮点转定点, 四舍五入. 只在设置参数时使用, 不在热路径上
+inline int32_t fromFloat(float value, int fracBits) {
+  float scaled = value * (float)(1L << fracBits);
+  return (int32_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+}
+
+inline float toFloat(int32_t value, int fracBits) {
+  return value / (float)(1L << fracBits);
+}
+
+// (a * b) >> shift, 四舍五入, 中间结果为64位
+inline int32_t mulShift(int32_t a, int32_t b, int shift) {
+  int64_t product = (int64_t)a * b;
+  return (int32_t)((product + ((int64_t)1 << (shift - 1))) >> shift);
+}
+
+// 归一化到 [0, turn). 偏离不超过一周时只用比较和加减, 不做除法
+inline int32_t wrap(int32_t value, int32_t turn) {
+  if (value >= 0) {
+    if (value < turn) return value;
+    if (value < 2 * turn) return value - turn;
+  } else if (value >= -turn) {
+    return value + turn;
+  }
+  value %= turn;
+  return value < 0 ? value + turn : value;
+}
+
+inline int32_t wrapCentideg(int32_t value) {
+  return wrap(value, kTurnCentideg);
+}
+
+// CORDIC 向量模式计算 atan2(y, x), 单位0.01度, 范围 (-18000, 18000].
+// 输入先归一化到固定的位宽, 与幅值无关; 误差小于0.01度. x 和 y 都为0时返回0
+int32_t atan2Centideg(int64_t y, int64_t x);
+
+} // namespace fixed
+
+#endif // FIXED_MATH_H
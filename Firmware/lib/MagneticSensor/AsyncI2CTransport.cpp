@@ -0,0 +1,74 @@
+#include "AsyncI2CTransport.h"
+
+AsyncI2CTransport::AsyncI2CTransport(i2c_port_t port, UBaseType_t depth,
+                                     TickType_t timeout)
+    : _port(port), _depth(depth), _timeout(timeout) {}
+
+AsyncI2CTransport::~AsyncI2CTransport() {
+  if (_task) {
+    vTaskDelete(_task);
+    _task = nullptr;
+  }
+  if (_queue) {
+    vQueueDelete(_queue);
+    _queue = nullptr;
+  }
+}
+
+bool AsyncI2CTransport::begin(UBaseType_t priority) {
+  if (_queue) {
+    return true;
+  }
+  _queue = xQueueCreate(_depth, sizeof(Request));
+  if (!_queue) {
+    return false;
+  }
+  if (xTaskCreate(_worker, "i2c", 2048, this, priority, &_task) != pdPASS) {
+    vQueueDelete(_queue);
+    _queue = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool AsyncI2CTransport::readRegisters(uint8_t address, uint8_t reg,
+                                      uint8_t *buffer, size_t length,
+                                      Callback callback, void *arg) {
+  return _submit({address, reg, 0, buffer, length, callback, arg});
+}
+
+bool AsyncI2CTransport::writeRegister(uint8_t address, uint8_t reg,
+                                      uint8_t value, Callback callback,
+                                      void *arg) {
+  return _submit({address, reg, value, nullptr, 0, callback, arg});
+}
+
+bool AsyncI2CTransport::_submit(const Request &request) {
+  // 不等待, 队列满说明总线已经跟不上
+  return _queue && xQueueSend(_queue, &request, 0) == pdTRUE;
+}
+
+void AsyncI2CTransport::_worker(void *self) {
+  AsyncI2CTransport *transport = static_cast<AsyncI2CTransport *>(self);
+  Request request;
+  for (;;) {
+    if (xQueueReceive(transport->_queue, &request, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    esp_err_t err;
+    if (request.buffer) {
+      // 写寄存器地址后重复起始, 一次事务读出全部数据
+      err = i2c_master_write_read_device(
+          transport->_port, request.address, &request.reg, 1, request.buffer,
+          request.length, transport->_timeout);
+    } else {
+      uint8_t data[2] = {request.reg, request.value};
+      err = i2c_master_write_to_device(transport->_port, request.address,
+                                       data, sizeof(data),
+                                       transport->_timeout);
+    }
+    if (request.callback) {
+      request.callback(request.arg, err == ESP_OK);
+    }
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef ASYNC_I2C_TRANSPORT_H
+#define ASYNC_I2C_TRANSPORT_H
+
+#include "I2CTransport.h"
+
+#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+// 基于 ESP-IDF I2C 驱动的异步传输: 请求放入队列, 由独立任务执行.
+// 驱动在传输期间阻塞于中断信号量, 不占用CPU, 提交请求的任务可以继续计算和渲染.
+// 与 Wire 共用已安装的端口驱动, 驱动内部的互斥锁保证两者的事务不会交错
+class AsyncI2CTransport : public I2CTransport {
+public:
+  explicit AsyncI2CTransport(i2c_port_t port = I2C_NUM_0,
+                             UBaseType_t depth = 8,
+                             TickType_t timeout = pdMS_TO_TICKS(10));
+  ~AsyncI2CTransport() override;
+
+  // 创建请求队列和传输任务
+  bool begin(UBaseType_t priority);
+
+  bool readRegisters(uint8_t address, uint8_t reg, uint8_t *buffer,
+                     size_t length, Callback callback, void *arg) override;
+  bool writeRegister(uint8_t address, uint8_t reg, uint8_t value,
+                     Callback callback = nullptr,
+                     void *arg = nullptr) override;
+
+private:
+  struct Request {
+    uint8_t address;
+    uint8_t reg;
+    uint8_t value;    // 写请求的数据
+    uint8_t *buffer;  // 读请求的目标, 写请求为空
+    size_t length;
+    Callback callback;
+    void *arg;
+  };
+
+  static void _worker(void *self);
+  bool _submit(const Request &request);
+
+  i2c_port_t _port;
+  UBaseType_t _depth;
+  TickType_t _timeout;
+  QueueHandle_t _queue = nullptr;
+  TaskHandle_t _task = nullptr;
+};
+
+#endif // ASYNC_I2C_TRANSPORT_H
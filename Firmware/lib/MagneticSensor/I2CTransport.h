@@ -0,0 +1,28 @@
+#ifndef I2C_TRANSPORT_H
+#define I2C_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// I2C 传输接口: 请求排队后立即返回, 按提交顺序执行,
+// 传输完成后在传输层的上下文中调用回调
+class I2CTransport {
+public:
+  // ok 为 false 表示设备无应答或超时
+  typedef void (*Callback)(void *arg, bool ok);
+
+  virtual ~I2CTransport() = default;
+
+  // 从 reg 开始连续读取 length 字节, buffer 在回调之前必须保持有效
+  // 队列满时返回 false, 此时不会调用回调
+  virtual bool readRegisters(uint8_t address, uint8_t reg, uint8_t *buffer,
+                             size_t length, Callback callback,
+                             void *arg) = 0;
+
+  // 写入一个寄存器, callback 可以为空
+  virtual bool writeRegister(uint8_t address, uint8_t reg, uint8_t value,
+                             Callback callback = nullptr,
+                             void *arg = nullptr) = 0;
+};
+
+#endif // I2C_TRANSPORT_H
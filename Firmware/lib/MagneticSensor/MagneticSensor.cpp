@@ -1,65 +1,98 @@
 #include "MagneticSensor.h"
 
-// 基类中 getAzimuth 的通用实现
-int MagneticSensor::getAzimuth() {
-    _applyCalibration(); // 确保数据已校准
-
-    // 计算水平方向的磁场矢量
-    float X_calibrated = (float)_vCalibrated[0];
-    float Y_calibrated = (float)_vCalibrated[1];
-
-    // 计算方位角 (atan2 返回弧度)
-    float azimuthRadians = atan2(Y_calibrated, X_calibrated);
-
-    // 转换为度数
-    int azimuthDegrees = (int)(azimuthRadians * 180.0 / PI);
-
-    // 调整到 0-360 度范围
-    azimuthDegrees += (int)_magneticDeclinationDegrees; // 应用磁偏角
-    if (azimuthDegrees < 0) azimuthDegrees += 360;
-    if (azimuthDegrees >= 360) azimuthDegrees -= 360;
-
-    return azimuthDegrees;
+int32_t MagneticSensor::_headingOf(int64_t x, int64_t y) const {
+    // atan2 只关心两个分量的比例, 不必移回整数
+    return fixed::wrapCentideg(fixed::atan2Centideg(y, x) + _declinationCentideg);
 }
 
-// 基类中 getBearing 的通用实现
-byte MagneticSensor::getBearing(int azimuth) {
-    // 将 0-360 度映射到 0-15 的象限
-    return (byte)(azimuth / 22.5 + 0.5); // +0.5 用于四舍五入
+void MagneticSensor::_updateFixedCalibration() {
+    for (int i = 0; i < 3; i++) {
+        _offsetFixed[i] = fixed::fromFloat(_offset[i], kFilterFracBits);
+        for (int j = 0; j < 3; j++) {
+            float value = _hasSoftIron ? _softIron[i][j] : (i == j ? _scale[i] : 0);
+            _matrixFixed[i][j] = fixed::fromFloat(value, kScaleFracBits);
+        }
+    }
+    _declinationCentideg = fixed::fromFloat(_magneticDeclinationDegrees * 100, 0);
 }
 
-// 基类中 getDirection 的通用实现
-void MagneticSensor::getDirection(char* myArray, int azimuth) {
-    byte index = getBearing(azimuth);
-    myArray[0] = _bearings[index][0];
-    myArray[1] = _bearings[index][1];
-    myArray[2] = _bearings[index][2];
-    myArray[3] = '\0'; // 确保字符串以空字符结尾
+int64_t MagneticSensor::_calibrateRow(int row, const int32_t v[3]) const {
+    int64_t sum = 0;
+    for (int j = 0; j < 3; j++) {
+        if (_matrixFixed[row][j] != 0) {
+            sum += (int64_t)(v[j] - _offsetFixed[j]) * _matrixFixed[row][j];
+        }
+    }
+    return sum;
+}
+// CIC 积分级: 每个输入采样两次加法
+void MagneticSensor::_integrate(const int in[3]) {
+    _cicIndex = (_cicIndex + 1) % (2 * kCicDelay + 1);
+    for (int i = 0; i < 3; i++) {
+        _cicIntegrator[0][i] += (uint32_t)in[i];
+        _cicIntegrator[1][i] += _cicIntegrator[0][i];
+        _cicHistory[_cicIndex][i] = _cicIntegrator[1][i];
+    }
 }
 
-// 基类中 _smoothing 的通用实现
-void MagneticSensor::_smoothing() {
-    if (!_smoothUse) return;
+void MagneticSensor::pushSample(int x, int y, int z) {
+    const int in[3] = {x, y, z};
+    if (_cicCount == 0) {
+        // 第一个采样: 按恒定输入预先填满梳状级的延迟线, 避免启动时的瞬态
+        for (int i = 0; i < 3; i++) {
+            _cicIntegrator[0][i] = _cicIntegrator[1][i] = 0;
+        }
+        for (int k = 0; k < 2 * kCicDelay; k++) {
+            _integrate(in);
+        }
+    }
+    _integrate(in);
+    _cicCount++;
+}
 
+bool MagneticSensor::getFiltered(int32_t out[3]) {
+    if (_cicCount == 0) return false;
+    const int size = 2 * kCicDelay + 1;
+    const uint32_t *now = _cicHistory[_cicIndex];
+    const uint32_t *delayed = _cicHistory[(_cicIndex + size - kCicDelay) % size];
+    const uint32_t *delayed2 = _cicHistory[(_cicIndex + 1) % size];
     for (int i = 0; i < 3; i++) {
-        _vTotals[i] -= _vHistory[_vScan][i]; // 减去最旧的值
-        _vHistory[_vScan][i] = _vRaw[i];     // 存入新值
-        _vTotals[i] += _vRaw[i];             // 加上新值
-        _vSmooth[i] = _vTotals[i] / _smoothSteps; // 计算平均值
+        // 梳状级: y = I[n] - 2I[n-R] + I[n-2R], 增益 R^2 即 kFilterFracBits 位小数
+        out[i] = (int32_t)(now[i] - 2 * delayed[i] + delayed2[i]);
     }
+    return true;
+}
 
-    _vScan++;
-    if (_vScan >= _smoothSteps) {
-        _vScan = 0; // 循环使用历史缓冲区
+void MagneticSensor::_decodeData(int16_t xyz[3]) const {
+    for (int i = 0; i < 3; i++) {
+        // 三种型号的数据寄存器都是低字节在前
+        xyz[i] = (int16_t)(_ioBuffer[2 * i] | _ioBuffer[2 * i + 1] << 8);
     }
 }
 
-// 基类中 _applyCalibration 的通用实现
-void MagneticSensor::_applyCalibration() {
-    // 如果使用了平滑，则对平滑后的数据进行校准；否则对原始数据进行校准
-    int* dataToCalibrate = _smoothUse ? _vSmooth : _vRaw;
+void MagneticSensor::_finishSample(const int16_t *xyz) {
+    SampleCallback callback = _sampleCallback;
+    void *arg = _sampleArg;
+    // 先清除忙标志, 回调中可以立即发起下一次请求
+    _sampleBusy = false;
+    callback(arg, xyz);
+}
 
-    _vCalibrated[0] = (int)((dataToCalibrate[0] - _offset[0]) * _scale[0]);
-    _vCalibrated[1] = (int)((dataToCalibrate[1] - _offset[1]) * _scale[1]);
-    _vCalibrated[2] = (int)((dataToCalibrate[2] - _offset[2]) * _scale[2]);
-}
\ No newline at end of file
+bool MagneticSensor::_wireRead(uint8_t address, uint8_t reg, uint8_t *buffer,
+                               size_t length) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    if (Wire.endTransmission() != 0) return false;
+    if (Wire.requestFrom(address, (uint8_t)length) != length) return false;
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = Wire.read();
+    }
+    return true;
+}
+
+void MagneticSensor::_wireWrite(uint8_t address, uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    Wire.write(value);
+    Wire.endTransmission();
+}
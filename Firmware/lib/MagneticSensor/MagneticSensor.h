@@ -2,109 +2,138 @@
 #define MAGNETIC_SENSOR_H
 
 #include "Arduino.h"
+#include "FixedMath.h"
+#include "I2CTransport.h"
 #include "Wire.h"
 
+// 各型号共用的部分: 校准参数, CIC抽取滤波, 定点方位角, 异步读取的状态.
+// 没有虚函数, 型号相关的寄存器和轴向由 Magnetometer<Traits> 在编译期确定
 class MagneticSensor {
 public:
   MagneticSensor() {}
 
-  virtual ~MagneticSensor() = default;
-
-  // --- 传感器初始化与配置 ---
-  virtual void init() = 0;
-  virtual void setMode(byte mode, byte odr, byte rng, byte osr) = 0;
-  virtual void setMagneticDeclination(int degrees, uint8_t minutes) {
+  void setMagneticDeclination(int degrees, uint8_t minutes) {
     _magneticDeclinationDegrees = degrees + (float)minutes / 60.0;
+    _updateFixedCalibration();
   }
-  virtual void setSmoothing(byte steps, bool adv) {
-    _smoothUse = true;
-    _smoothSteps = steps;
-    _smoothAdvanced = adv;
-  }
-  virtual void clearSmoothing() { _smoothUse = false; }
 
   // --- 校准相关 ---
-  virtual void calibrate() = 0;
-  virtual void setCalibration(int x_min, int x_max, int y_min, int y_max,
-                              int z_min, int z_max) {
+  void setCalibration(int x_min, int x_max, int y_min, int y_max, int z_min,
+                      int z_max) {
     _offset[0] = (float)(x_min + x_max) / 2.0;
     _offset[1] = (float)(y_min + y_max) / 2.0;
     _offset[2] = (float)(z_min + z_max) / 2.0;
     _scale[0] = (float)2.0 / (x_max - x_min);
     _scale[1] = (float)2.0 / (y_max - y_min);
     _scale[2] = (float)2.0 / (z_max - z_min);
+    _hasSoftIron = false;
+    _updateFixedCalibration();
   }
-  virtual void setCalibrationOffsets(float x_offset, float y_offset,
-                                     float z_offset) {
+  void setCalibrationOffsets(float x_offset, float y_offset, float z_offset) {
     _offset[0] = x_offset;
     _offset[1] = y_offset;
     _offset[2] = z_offset;
+    _updateFixedCalibration();
   }
-  virtual void setCalibrationScales(float x_scale, float y_scale,
-                                    float z_scale) {
+  void setCalibrationScales(float x_scale, float y_scale, float z_scale) {
     _scale[0] = x_scale;
     _scale[1] = y_scale;
     _scale[2] = z_scale;
+    _hasSoftIron = false;
+    _updateFixedCalibration();
+  }
+  // 软磁校准矩阵: 校准值 = matrix * (原始值 - offset), 代替按轴的 scale.
+  // 再次调用 setCalibrationScales / setCalibration 时恢复为按轴缩放
+  void setSoftIronMatrix(const float matrix[3][3]) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        _softIron[i][j] = matrix[i][j];
+      }
+      _scale[i] = matrix[i][i];
+    }
+    _hasSoftIron = true;
+    _updateFixedCalibration();
   }
-  virtual float getCalibrationOffset(uint8_t index) {
+  float getCalibrationOffset(uint8_t index) {
     if (index < 3)
       return _offset[index];
     return 0.0;
   }
-  virtual float getCalibrationScale(uint8_t index) {
+  float getCalibrationScale(uint8_t index) {
     if (index < 3)
       return _scale[index];
     return 0.0;
   }
-  virtual void clearCalibration() {
+  void clearCalibration() {
     _offset[0] = _offset[1] = _offset[2] = 0.0;
     _scale[0] = _scale[1] = _scale[2] = 1.0;
+    _hasSoftIron = false;
+    _updateFixedCalibration();
   }
 
-  // --- 数据读取与处理 ---
-  virtual void setReset() = 0;
-  virtual void read() = 0;
-  virtual int getX() {
-    _applyCalibration();
-    return _vCalibrated[0];
-  }
-  virtual int getY() {
-    _applyCalibration();
-    return _vCalibrated[1];
-  }
-  virtual int getZ() {
-    _applyCalibration();
-    return _vCalibrated[2];
-  }
-  virtual int getAzimuth();
-  virtual byte getBearing(int azimuth);
-  virtual void getDirection(char *myArray, int azimuth);
-  virtual char chipID() = 0;
+  // --- 抽取滤波 ---
+  // 二阶CIC抽取滤波器, 冲激响应为 [1,2,3,4,3,2,1]/16, 群延迟3个采样.
+  // 积分器以传感器输出速率运行, 梳状级只在取输出时计算, 输出速率不必是输入的整数分之一
+  static const int kCicDelay = 4;
+  // 滤波输出的小数位数: 增益 kCicDelay^2 = 2^4, 梳状级的输出直接当作定点数使用
+  static const int kFilterFracBits = 4;
+  static_assert(kCicDelay * kCicDelay == 1 << kFilterFracBits,
+                "CIC gain must be a power of two");
+  // 以传感器输出速率送入每一个未校准采样
+  void pushSample(int x, int y, int z);
+  // 当前的滤波输出(未校准, kFilterFracBits 位小数), 还没有送入过采样时返回 false
+  bool getFiltered(int32_t out[3]);
+  void resetFilter() { _cicCount = 0; }
 
-protected:
+  // --- 异步读取 ---
+  // xyz 为读到的未校准读数, 只在回调期间有效; 没有读到新数据时为 nullptr.
+  // 回调在传输层的任务中执行, 需要的数据应在回调中复制出去
+  typedef void (*SampleCallback)(void *arg, const int16_t *xyz);
+  void setTransport(I2CTransport *transport) { _transport = transport; }
 
+protected:
   float _magneticDeclinationDegrees = 0;
-  bool _smoothUse = false;
-  byte _smoothSteps = 5;
-  bool _smoothAdvanced = false;
-  int _vRaw[3] = {0, 0, 0};
-  int _vHistory[10][3];
-  int _vScan = 0;
-  long _vTotals[3] = {0, 0, 0};
-  int _vSmooth[3] = {0, 0, 0};
   float _offset[3] = {0., 0., 0.};
   float _scale[3] = {1., 1., 1.};
-  int _vCalibrated[3];
+  float _softIron[3][3];
+  bool _hasSoftIron = false;
+
+  // 校准参数的定点数副本, 由 _updateFixedCalibration 在每次修改后刷新
+  static const int kScaleFracBits = 24;
+  int32_t _offsetFixed[3] = {0, 0, 0}; // kFilterFracBits 位小数
+  // 按轴缩放时为对角阵
+  fixed::q24_t _matrixFixed[3][3] = {{1 << kScaleFracBits, 0, 0},
+                                     {0, 1 << kScaleFracBits, 0},
+                                     {0, 0, 1 << kScaleFracBits}};
+  int32_t _declinationCentideg = 0;
+  void _updateFixedCalibration();
+  // matrix 的第 row 行乘以 (v - offset), 结果有 kFilterFracBits + kScaleFracBits 位小数
+  int64_t _calibrateRow(int row, const int32_t v[3]) const;
+  // 机体坐标系下的水平分量换算为方位角并加上磁偏角, 单位0.01度, 范围[0, 36000)
+  int32_t _headingOf(int64_t x, int64_t y) const;
+
+  I2CTransport *_transport = nullptr;
+  uint8_t _ioBuffer[6];
+  volatile bool _sampleBusy = false;
+  SampleCallback _sampleCallback = nullptr;
+  void *_sampleArg = nullptr;
+
+  // 解码 _ioBuffer 中的6字节数据(低字节在前)
+  void _decodeData(int16_t xyz[3]) const;
+  void _finishSample(const int16_t *xyz);
+  // 没有传输层时经 Wire 同步访问寄存器
+  static bool _wireRead(uint8_t address, uint8_t reg, uint8_t *buffer,
+                        size_t length);
+  static void _wireWrite(uint8_t address, uint8_t reg, uint8_t value);
 
-  virtual void _smoothing();
-  virtual void _applyCalibration();
+  // CIC 积分器状态, 按模 2^32 运算, 梳状级相减后溢出互相抵消
+  uint32_t _cicIntegrator[2][3] = {{0, 0, 0}, {0, 0, 0}};
+  // 第二级积分器最近 2*kCicDelay+1 个输出
+  uint32_t _cicHistory[2 * kCicDelay + 1][3];
+  uint8_t _cicIndex = 0;
+  uint32_t _cicCount = 0;
 
-  const char _bearings[16][3] = {
-      {' ', ' ', 'N'}, {'N', 'N', 'E'}, {' ', 'N', 'E'}, {'E', 'N', 'E'},
-      {' ', ' ', 'E'}, {'E', 'S', 'E'}, {' ', 'S', 'E'}, {'S', 'S', 'E'},
-      {' ', ' ', 'S'}, {'S', 'S', 'W'}, {' ', 'S', 'W'}, {'W', 'S', 'W'},
-      {' ', ' ', 'W'}, {'W', 'N', 'W'}, {' ', 'N', 'W'}, {'N', 'N', 'W'},
-  };
+  void _integrate(const int in[3]);
 };
 
 #endif // MAGNETIC_SENSOR_H
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef MAGNETOMETER_H
+#define MAGNETOMETER_H
+
+#include "MagneticSensor.h"
+#include "MagnetometerTraits.h"
+
+// 按型号特化的驱动: 寄存器地址, 触发方式和轴向都来自 Traits 的编译期常量,
+// 采样和方位角计算没有虚函数调用, 也不需要按型号分支.
+// 探测到型号后只实例化一次, 由调用方保存一个指向对应实例化的函数指针
+template <typename Traits> class Magnetometer : public MagneticSensor {
+public:
+  // 经 Wire 读一次芯片ID寄存器, 确认 Traits::kAddress 上是这个型号
+  static bool identify() {
+    uint8_t id;
+    return _wireRead(Traits::kAddress, Traits::kChipIdRegister, &id, 1) &&
+           id == Traits::kChipId;
+  }
+
+  // 按 Traits::initSequence 写入配置寄存器, 在设置传输层之前经 Wire 完成
+  void init() {
+    const RegisterWrite *steps;
+    size_t count = Traits::initSequence(steps);
+    for (size_t i = 0; i < count; i++) {
+      _wireWrite(Traits::kAddress, steps[i].reg, steps[i].value);
+      if (steps[i].delayMs > 0) {
+        delay(steps[i].delayMs);
+      }
+    }
+  }
+
+  // 静止时降低输出数据率, 有传输层时排队写入.
+  // 传输层队列满, 写入没有排上时返回 false, 由调用方重试
+  bool setIdle(bool idle) {
+    if (Traits::kOdrRegister == kNoRegister) return true;
+    uint8_t value = idle ? Traits::kOdrIdle : Traits::kOdrActive;
+    if (_transport) {
+      return _transport->writeRegister(Traits::kAddress, Traits::kOdrRegister,
+                                       value);
+    }
+    _wireWrite(Traits::kAddress, Traits::kOdrRegister, value);
+    return true;
+  }
+
+  // 经传输层排队读取状态寄存器, 数据就绪时再突发读取6字节数据, 完成后调用 callback.
+  // 未设置传输层时经 Wire 同步完成. 上一次请求未完成时返回 false
+  bool requestSample(SampleCallback callback, void *arg) {
+    if (_sampleBusy) return false;
+    if (!_transport) {
+      int16_t xyz[3];
+      callback(arg, _readSync(xyz) ? xyz : nullptr);
+      return true;
+    }
+    _sampleBusy = true;
+    _sampleCallback = callback;
+    _sampleArg = arg;
+    if (!_transport->readRegisters(Traits::kAddress, Traits::kStatusRegister,
+                                   _ioBuffer, 1, _onStatus, this)) {
+      _sampleBusy = false;
+      return false;
+    }
+    return true;
+  }
+
+  // 用给定的未校准读数计算方位角, 单位0.01度, 范围[0, 36000).
+  // v 为 kFilterFracBits 位小数的定点数(滤波输出), 校准, 轴向换算和 atan2 都用整数完成
+  int32_t getAzimuthCentideg(const int32_t v[3]) const {
+    int64_t x = _calibrateRow(0, v);
+    int64_t y = _calibrateRow(1, v);
+    return _headingOf(Traits::kAxisXX * x + Traits::kAxisXY * y,
+                      Traits::kAxisYX * x + Traits::kAxisYY * y);
+  }
+
+  // 用滤波输出计算方位角, 还没有送入过采样时返回0
+  int32_t getFilteredAzimuthCentideg() {
+    int32_t filtered[3];
+    if (!getFiltered(filtered)) {
+      return 0;
+    }
+    return getAzimuthCentideg(filtered);
+  }
+
+private:
+  bool _readSync(int16_t xyz[3]) {
+    // 数据未就绪(DRDY=0)或总线错误时不读数据
+    if (!_wireRead(Traits::kAddress, Traits::kStatusRegister, _ioBuffer, 1) ||
+        !(_ioBuffer[0] & 0x01) ||
+        !_wireRead(Traits::kAddress, Traits::kDataRegister, _ioBuffer, 6)) {
+      return false;
+    }
+    _decodeData(xyz);
+    if (Traits::kTriggerRegister != kNoRegister) {
+      _wireWrite(Traits::kAddress, Traits::kTriggerRegister,
+                 Traits::kTriggerValue);
+    }
+    return true;
+  }
+
+  static void _onStatus(void *self, bool ok) {
+    Magnetometer *sensor = static_cast<Magnetometer *>(self);
+    if (!ok || !(sensor->_ioBuffer[0] & 0x01)) {
+      sensor->_finishSample(nullptr);
+      return;
+    }
+    if (!sensor->_transport->readRegisters(Traits::kAddress,
+                                           Traits::kDataRegister,
+                                           sensor->_ioBuffer, 6, _onData,
+                                           sensor)) {
+      sensor->_finishSample(nullptr);
+    }
+  }
+
+  static void _onData(void *self, bool ok) {
+    Magnetometer *sensor = static_cast<Magnetometer *>(self);
+    int16_t xyz[3];
+    if (ok) {
+      sensor->_decodeData(xyz);
+      if (Traits::kTriggerRegister != kNoRegister) {
+        sensor->_transport->writeRegister(Traits::kAddress,
+                                          Traits::kTriggerRegister,
+                                          Traits::kTriggerValue);
+      }
+    }
+    sensor->_finishSample(ok ? xyz : nullptr);
+  }
+};
+
+typedef Magnetometer<QMC5883LTraits> QMC5883LDriver;
+typedef Magnetometer<QMC5883PTraits> QMC5883PDriver;
+typedef Magnetometer<MMC5883MATraits> MMC5883MADriver;
+
+#endif // MAGNETOMETER_H
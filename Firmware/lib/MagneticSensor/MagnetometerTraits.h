@@ -0,0 +1,109 @@
+#ifndef MAGNETOMETER_TRAITS_H
+#define MAGNETOMETER_TRAITS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 各型号的寄存器表和轴向, 作为 Magnetometer<Traits> 的模板参数在编译期展开.
+//
+// kAxis*: 机体坐标系的水平分量 = kAxis * 传感器的 (X, Y), 指南针的方位角为
+// atan2(机体Y, 机体X). 元素只取 -1/0/1, 乘法在编译期消去.
+// kTriggerRegister: 每次读取数据后写入 kTriggerValue 开始下一次测量,
+// 连续测量模式的型号为 kNoRegister.
+// kChipIdRegister/kChipId: 启动时读一次确认型号.
+// kOdrRegister: 静止时写入 kOdrIdle 降低输出数据率, 运动时写回 kOdrActive;
+// 单次测量的型号由触发频率决定, 为 kNoRegister.
+
+// 初始化时依次写入的寄存器
+struct RegisterWrite {
+  uint8_t reg;
+  uint8_t value;
+  uint8_t delayMs; // 写入后等待的时间
+};
+
+static constexpr uint8_t kNoRegister = 0xFF;
+
+struct QMC5883LTraits {
+  static constexpr uint8_t kAddress = 0x0D;
+  static constexpr uint8_t kStatusRegister = 0x06;
+  static constexpr uint8_t kDataRegister = 0x00;
+  static constexpr uint8_t kChipIdRegister = 0x0D;
+  static constexpr uint8_t kChipId = 0xFF;
+  static constexpr uint8_t kTriggerRegister = kNoRegister;
+  static constexpr uint8_t kTriggerValue = 0x00;
+  // 与 initSequence 相同, 只改变 ODR: 200Hz 0x0C / 10Hz 0x00
+  static constexpr uint8_t kOdrRegister = 0x09;
+  static constexpr uint8_t kOdrActive = 0x01 | 0x0C | 0x10 | 0x00;
+  static constexpr uint8_t kOdrIdle = 0x01 | 0x00 | 0x10 | 0x00;
+  // Y轴与机体坐标相反, 方位角 = 360 - atan2(Y, X)
+  static constexpr int kAxisXX = 1, kAxisXY = 0;
+  static constexpr int kAxisYX = 0, kAxisYY = -1;
+
+  static size_t initSequence(const RegisterWrite *&steps) {
+    static const RegisterWrite kSteps[] = {
+        {0x0B, 0x01, 0}, // SET/RESET 周期
+        // 连续测量 0x01 | 200Hz 0x0C | 8G 0x10 | OSR 512 0x00
+        {0x09, 0x01 | 0x0C | 0x10 | 0x00, 0},
+    };
+    steps = kSteps;
+    return sizeof(kSteps) / sizeof(kSteps[0]);
+  }
+};
+
+struct QMC5883PTraits {
+  static constexpr uint8_t kAddress = 0x2C;
+  static constexpr uint8_t kStatusRegister = 0x09;
+  static constexpr uint8_t kDataRegister = 0x01;
+  static constexpr uint8_t kChipIdRegister = 0x00;
+  static constexpr uint8_t kChipId = 0x80;
+  static constexpr uint8_t kTriggerRegister = kNoRegister;
+  static constexpr uint8_t kTriggerValue = 0x00;
+  // 与 initSequence 相同, 只改变 ODR: 200Hz 0x0C / 10Hz 0x00
+  static constexpr uint8_t kOdrRegister = 0x0A;
+  static constexpr uint8_t kOdrActive = 0x03 | 0x0C | 0x00;
+  static constexpr uint8_t kOdrIdle = 0x03 | 0x00 | 0x00;
+  // 相对 QMC5883L 旋转了90度, 方位角 = atan2(Y, X) + 90
+  static constexpr int kAxisXX = 0, kAxisXY = -1;
+  static constexpr int kAxisYX = 1, kAxisYY = 0;
+
+  static size_t initSequence(const RegisterWrite *&steps) {
+    static const RegisterWrite kSteps[] = {
+        {0x0B, 0x08 | 0x01, 0}, // 8G 0x08 | SET/RESET 打开 0x01
+        // 连续测量 0x03 | 200Hz 0x0C | OSR1 8 0x00
+        {0x0A, 0x03 | 0x0C | 0x00, 0},
+    };
+    steps = kSteps;
+    return sizeof(kSteps) / sizeof(kSteps[0]);
+  }
+};
+
+struct MMC5883MATraits {
+  static constexpr uint8_t kAddress = 0x30;
+  static constexpr uint8_t kStatusRegister = 0x07;
+  static constexpr uint8_t kDataRegister = 0x00;
+  // Product ID 寄存器
+  static constexpr uint8_t kChipIdRegister = 0x2F;
+  static constexpr uint8_t kChipId = 0x0C;
+  // 单次测量: 每次读取数据后写 Control 0 的 TM_M 触发下一次测量
+  static constexpr uint8_t kTriggerRegister = 0x08;
+  static constexpr uint8_t kTriggerValue = 0x01;
+  static constexpr uint8_t kOdrRegister = kNoRegister;
+  static constexpr uint8_t kOdrActive = 0x00;
+  static constexpr uint8_t kOdrIdle = 0x00;
+  static constexpr int kAxisXX = 1, kAxisXY = 0;
+  static constexpr int kAxisYX = 0, kAxisYY = 1;
+
+  static size_t initSequence(const RegisterWrite *&steps) {
+    static const RegisterWrite kSteps[] = {
+        {0x09, 0x80, 5}, // 软件复位, 等待5ms
+        {0x09, 0x10, 0}, // Control 1: 带宽 400Hz
+        {0x08, 0x08, 1}, // SET
+        {0x08, 0x10, 1}, // RESET, 消除零点偏移
+        {0x08, 0x01, 0}, // TM_M, 开始第一次测量
+    };
+    steps = kSteps;
+    return sizeof(kSteps) / sizeof(kSteps[0]);
+  }
+};
+
+#endif // MAGNETOMETER_TRAITS_H
@@ -1,38 +0,0 @@
-/*
-===============================================================================================================
-QMC5883LCompass.h Library Azimuth Example Sketch
-Learn more at [https://github.com/mprograms/QMC5883Compas]
-===============================================================================================================
-v0.3 - June 12, 2019
-Written by MRPrograms 
-Github: [https://github.com/mprograms/]
-
-Release under the GNU General Public License v3
-[https://www.gnu.org/licenses/gpl-3.0.en.html]
-===============================================================================================================
-*/
-#include <QMC5883LCompass.h>
-
-QMC5883LCompass compass;
-
-void setup() {
-  Serial.begin(9600);
-  compass.init();
-  
-}
-
-void loop() {
-  int a;
-  
-  // Read compass values
-  compass.read();
-
-  // Return Azimuth reading
-  a = compass.getAzimuth();
-  
-  Serial.print("A: ");
-  Serial.print(a);
-  Serial.println();
-  
-  delay(250);
-}
@@ -1,74 +0,0 @@
-/*
-QMC5883LCompass.h Library Calibration Example Sketch
-Learn more at [https://github.com/mprograms/QMC5883LCompass]
-
-Upload this calibration sketch onto your Arduino to provide calibration for your QMC5883L chip.
-After upload, run the serial monitor and follow the directions.
-When prompted, copy the last line into your project's actual sketch.
-
-===============================================================================================================
-Release under the GNU General Public License v3
-[https://www.gnu.org/licenses/gpl-3.0.en.html]
-===============================================================================================================
-
-
-
-
-
-
-
-
-
-
-
-                                          UTILITY SKETCH
-                                    NO SERVICABLE PARTS BELOW
-
-
-
-
-
-
-
-
-
-
-
-
-*/
-#include <QMC5883LCompass.h>
-
-QMC5883LCompass compass;
-
-void setup() {
-  Serial.begin(9600);
-  compass.init();
-  
-  Serial.println("This will provide calibration settings for your QMC5883L chip. When prompted, move the magnetometer in all directions until the calibration is complete.");
-  Serial.println("Calibration will begin in 5 seconds.");
-  delay(5000);
-
-  Serial.println("CALIBRATING. Keep moving your sensor...");
-  compass.calibrate();
-
-  Serial.println("DONE. Copy the lines below and paste it into your projects sketch.);");
-  Serial.println();
-  Serial.print("compass.setCalibrationOffsets(");
-  Serial.print(compass.getCalibrationOffset(0));
-  Serial.print(", ");
-  Serial.print(compass.getCalibrationOffset(1));
-  Serial.print(", ");
-  Serial.print(compass.getCalibrationOffset(2));
-  Serial.println(");");
-  Serial.print("compass.setCalibrationScales(");
-  Serial.print(compass.getCalibrationScale(0));
-  Serial.print(", ");
-  Serial.print(compass.getCalibrationScale(1));
-  Serial.print(", ");
-  Serial.print(compass.getCalibrationScale(2));
-  Serial.println(");");
-}
-
-void loop() {
-  delay(1000);
-}
\ No newline at end of file
@@ -1,36 +0,0 @@
-/*
-===============================================================================================================
-QMC5883LCompass.h Library Direction Example Sketch
-Learn more at [https://github.com/mprograms/QMC5883Compas]
-
-This example shows how to get Compass direction.
-
-===============================================================================================================
-Release under the GNU General Public License v3
-[https://www.gnu.org/licenses/gpl-3.0.en.html]
-===============================================================================================================
-*/
-#include <QMC5883LCompass.h>
-
-QMC5883LCompass compass;
-
-void setup() {
-  Serial.begin(9600);
-  compass.init();
-}
-
-void loop() {
-  compass.read();
-  
-  byte a = compass.getAzimuth();
-
-  char myArray[3];
-  compass.getDirection(myArray, a);
-  
-  Serial.print(myArray[0]);
-  Serial.print(myArray[1]);
-  Serial.print(myArray[2]);
-  Serial.println();
-  
-  delay(250);
-}
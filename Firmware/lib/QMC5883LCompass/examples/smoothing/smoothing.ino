@@ -1,54 +0,0 @@
-/*
-===============================================================================================================
-QMC5883LCompass.h Library XYZ Example Sketch
-Learn more at [https://github.com/mprograms/QMC5883Compas]
-
-This example shows how to use smoothing to get more stable readings.
-
-===============================================================================================================
-Release under the GNU General Public License v3
-[https://www.gnu.org/licenses/gpl-3.0.en.html]
-===============================================================================================================
-*/
-#include <QMC5883LCompass.h>
-
-QMC5883LCompass compass;
-
-void setup() {
-  Serial.begin(9600);
-  compass.init();
-
-  /*
-   *   call setSmoothing(STEPS, ADVANCED);
-   *   
-   *   STEPS     = int   The number of steps to smooth the results by. Valid 1 to 10.
-   *                     Higher steps equals more smoothing but longer process time.
-   *                     
-   *   ADVANCED  = bool  Turn advanced smmothing on or off. True will remove the max and min values from each step and then process as normal.
-   *                     Turning this feature on will results in even more smoothing but will take longer to process.
-   *                     
-   */
-  compass.setSmoothing(10,true);  
-}
-
-void loop() {
-  int x, y, z;
-  
-  // Read compass values
-  compass.read();
-
-  // Return XYZ readings
-  x = compass.getX();
-  y = compass.getY();
-  z = compass.getZ();
-  
-  Serial.print("X: ");
-  Serial.print(x);
-  Serial.print(" Y: ");
-  Serial.print(y);
-  Serial.print(" Z: ");
-  Serial.print(z);
-  Serial.println();
-  
-  delay(250);
-}
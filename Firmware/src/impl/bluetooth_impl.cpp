@@ -57,6 +57,22 @@ class CharacteristicCallbacks : public NimBLECharacteristicCallbacks {
     } else if (pCharacteristic->getUUID().equals(
                    NimBLEUUID(SERVER_MODE_CHARACTERISTIC_UUID))) {
       characteristic = "Web Server";
+    } else if (pCharacteristic->getUUID().equals(
+                   NimBLEUUID(METRICS_CHARACTERISTIC_UUID))) {
+      characteristic = "Metrics";
+      // 读取时才生成, 避免周期性更新的开销. 受属性最大长度限制,
+      // 放不下的条目被省略
+      char metricsJson[BLE_ATT_ATTR_MAX_LEN + 1];
+      if (metrics::toJson(metricsJson, sizeof(metricsJson))) {
+        pCharacteristic->setValue(metricsJson);
+      }
+    } else if (pCharacteristic->getUUID().equals(
+                   NimBLEUUID(EVENT_METRICS_CHARACTERISTIC_UUID))) {
+      characteristic = "Event Metrics";
+      char metricsJson[BLE_ATT_ATTR_MAX_LEN + 1];
+      if (metrics::eventsToJson(metricsJson, sizeof(metricsJson))) {
+        pCharacteristic->setValue(metricsJson);
+      }
     } else if (pCharacteristic->getUUID().equals(
                    NimBLEUUID(BRIGHTNESS_CHARACTERISTIC_UUID))) {
       characteristic = "Brightness";
@@ -157,9 +173,7 @@ class CharacteristicCallbacks : public NimBLECharacteristicCallbacks {
       Event::Body event;
       event.type = Event::Type::FACTORY_RESET;
       event.source = Event::Source::BLE;
-      auto eventLoop = context.getEventLoop();
-      ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0, &event,
-                                        sizeof(event), portMAX_DELAY));
+      context.postEvent(event);
     } else if (pCharacteristic->getUUID().equals(
                    NimBLEUUID(SERVER_MODE_CHARACTERISTIC_UUID))) {
       std::string value = pCharacteristic->getValue();
@@ -181,8 +195,8 @@ class CharacteristicCallbacks : public NimBLECharacteristicCallbacks {
         Context &context = Context::getInstance();
         uint8_t brightness = static_cast<uint8_t>(value[0]);
         preference::setBrightness(brightness);
+        // 渲染任务在下一帧应用
         context.setBrightness(brightness);
-        pixel::setBrightness(brightness);
       } else {
         ESP_LOGE(TAG, "Error: Invalid brightness value length");
       }
@@ -195,9 +209,7 @@ class CharacteristicCallbacks : public NimBLECharacteristicCallbacks {
       Event::Body event;
       event.type = Event::Type::SENSOR_CALIBRATE;
       event.source = Event::Source::BLE;
-      auto eventLoop = context.getEventLoop();
-      ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0, &event,
-                                        sizeof(event), portMAX_DELAY));
+      context.postEvent(event);
     } else if (pCharacteristic->getUUID().equals(
                    NimBLEUUID(CUSTOM_MODEL_CHARACTERISTIC_UUID))) {
       std::string value = pCharacteristic->getValue();
@@ -240,41 +252,39 @@ class CharacteristicCallbacks : public NimBLECharacteristicCallbacks {
   }
 } chrCallbacks;
 
-static void ble_azimuth_dispatcher(void *handler_arg, esp_event_base_t base,
-                                   int32_t id, void *event_data) {
-  static uint32_t last_update = 0;
-  if (millis() - last_update < 1000)
+static esp_timer_handle_t notifyTimer = nullptr;
+
+// 方位角通知, 限制频率1Hz
+static void ble_notify_azimuth(void *) {
+  if (pServer->getConnectedCount() == 0) {
     return;
-  last_update = millis();
-  Event::Body *evt = (Event::Body *)event_data;
-  switch (evt->type) {
-  case Event::Type::AZIMUTH: {
-    if (pServer->getConnectedCount() > 0) {
-      // 校验刷新频率, 限制帧率1Hz
-      ESP_LOGI(TAG, "Notify Azimuth: %d", evt->azimuth.angle);
-      NimBLEService *pSvc =
-          pServer->getServiceByUUID(NimBLEUUID(BASE_SERVICE_UUID));
-      if (pSvc) {
-        NimBLECharacteristic *pChr =
-            pSvc->getCharacteristic(NimBLEUUID(AZIMUTH_CHARACHERSITC_UUID), 0);
-        pChr->setValue(sensor::getAzimuth());
-        if (pChr) {
-          pChr->notify();
-        }
-        Context &context = Context::getInstance();
-        pChr = pSvc->getCharacteristic(NimBLEUUID(INFO_CHARACTERISTIC_UUID), 0);
-        String infoJson =
-            "{\"buildDate\":\"" + String(__DATE__) + "\",\"buildTime\":\"" +
-            String(__TIME__) + "\",\"buildVersion\":\"" +
-            String(BUILD_VERSION) + "\",\"gitBranch\":\"" + String(GIT_BRANCH) +
-            "\",\"gpsStatus\":\"" + (context.getDetectGPS() ? "1" : "0") +
-            "\",\"model\":\"" + (context.isGPSModel() ? "1" : "0") +
-            "\",\"sensorStatus\":\"" + (context.getHasSensor() ? "1" : "0") +
-            "\",\"gitCommit\":\"" + String(GIT_COMMIT) + "\"}";
-        pChr->setValue(infoJson);
-      }
+  }
+  // 取邮箱中传感器的最新值, 不再额外读取一次I2C
+  angle::Centideg centideg = 0;
+  mailbox::read(Event::Source::SENSOR, centideg);
+  // 特征值保持整数度, 与App的协议一致
+  int azimuth = centideg / angle::PER_DEGREE;
+  ESP_LOGI(TAG, "Notify Azimuth: %d", azimuth);
+  NimBLEService *pSvc =
+      pServer->getServiceByUUID(NimBLEUUID(BASE_SERVICE_UUID));
+  if (pSvc) {
+    NimBLECharacteristic *pChr =
+        pSvc->getCharacteristic(NimBLEUUID(AZIMUTH_CHARACHERSITC_UUID), 0);
+    pChr->setValue(azimuth);
+    if (pChr) {
+      pChr->notify();
     }
-  } break;
+    Context &context = Context::getInstance();
+    pChr = pSvc->getCharacteristic(NimBLEUUID(INFO_CHARACTERISTIC_UUID), 0);
+    String infoJson =
+        "{\"buildDate\":\"" + String(__DATE__) + "\",\"buildTime\":\"" +
+        String(__TIME__) + "\",\"buildVersion\":\"" + String(BUILD_VERSION) +
+        "\",\"gitBranch\":\"" + String(GIT_BRANCH) + "\",\"gpsStatus\":\"" +
+        (context.getDetectGPS() ? "1" : "0") + "\",\"model\":\"" +
+        (context.isGPSModel() ? "1" : "0") + "\",\"sensorStatus\":\"" +
+        (context.getHasSensor() ? "1" : "0") + "\",\"gitCommit\":\"" +
+        String(GIT_COMMIT) + "\"}";
+    pChr->setValue(infoJson);
   }
 }
 
@@ -373,6 +383,16 @@ void ble_server::init(Context *context) {
       NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::READ);
   customModelChar->setValue(static_cast<uint8_t>(context->getModel()));
   customModelChar->setCallbacks(&chrCallbacks);
+  // 运行统计, 只读
+  NimBLECharacteristic *metricsChar = baseService->createCharacteristic(
+      NimBLEUUID(METRICS_CHARACTERISTIC_UUID), NIMBLE_PROPERTY::READ);
+  metricsChar->setValue("{}");
+  metricsChar->setCallbacks(&chrCallbacks);
+  // 事件队列统计, 只读
+  NimBLECharacteristic *eventMetricsChar = baseService->createCharacteristic(
+      NimBLEUUID(EVENT_METRICS_CHARACTERISTIC_UUID), NIMBLE_PROPERTY::READ);
+  eventMetricsChar->setValue("{}");
+  eventMetricsChar->setCallbacks(&chrCallbacks);
 
   baseService->start();
   advancedService->start();
@@ -386,8 +406,15 @@ void ble_server::init(Context *context) {
 
   serverEnable = true;
   Serial.printf("Advertising Started\n");
-  esp_event_handler_register_with(context->getEventLoop(), MCOMPASS_EVENT, 0,
-                                  ble_azimuth_dispatcher, NULL);
+  // 方位角不再经过事件队列, 改为定时通知
+  esp_timer_create_args_t notifyTimerArgs = {
+      .callback = ble_notify_azimuth,
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "ble_notify_timer",
+      .skip_unhandled_events = true};
+  esp_timer_create(&notifyTimerArgs, &notifyTimer);
+  esp_timer_start_periodic(notifyTimer, 1000000); // 1s
   // 定时器, 用于关闭蓝牙
   esp_timer_handle_t deinitTimer;
   esp_timer_create_args_t timerConfig = {
@@ -421,8 +448,11 @@ void ble_server::deinit(Context *context) {
     return;
   }
   ESP_LOGW(TAG, "deinit");
-  esp_event_handler_unregister_with(context->getEventLoop(), MCOMPASS_EVENT, 0,
-                                    ble_azimuth_dispatcher);
+  if (notifyTimer != nullptr) {
+    esp_timer_stop(notifyTimer);
+    esp_timer_delete(notifyTimer);
+    notifyTimer = nullptr;
+  }
   NimBLEDevice::deinit(false);
   esp_bt_controller_disable();
   serverEnable = false;
@@ -20,9 +20,7 @@ void button::init(Context *context) {
         Event::Body event;
         event.type = Event::Type::BUTTON_CLICK;
         event.source = Event::Source::BUTTON;
-        auto eventLoop = context->getEventLoop();
-        ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0, &event,
-                                          sizeof(event), portMAX_DELAY));
+        context->postEvent(event);
       },
       ctx);
   // 多次点击
@@ -34,20 +32,14 @@ void button::init(Context *context) {
           Event::Body event;
           event.type = Event::Type::FACTORY_RESET;
           event.source = Event::Source::BUTTON;
-          auto eventLoop = context->getEventLoop();
-          ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0,
-                                            &event, sizeof(event),
-                                            portMAX_DELAY));
+          context->postEvent(event);
         } else if (buttonInstance.getNumberClicks() == 6) {
           // 六次点击,传感器校准
           auto context = static_cast<Context *>(ctx);
           Event::Body event;
           event.type = Event::Type::SENSOR_CALIBRATE;
           event.source = Event::Source::BUTTON;
-          auto eventLoop = context->getEventLoop();
-          ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0,
-                                            &event, sizeof(event),
-                                            portMAX_DELAY));
+          context->postEvent(event);
         } else if (buttonInstance.getNumberClicks() == 4) {
           // 四次点击,显示IP
           if (WiFi.getMode() != WIFI_AP && WiFi.localIP() == INADDR_NONE) {
@@ -64,13 +56,15 @@ void button::init(Context *context) {
           } else {
             strcpy(event.TEXT.text, WiFi.localIP().toString().c_str());
           }
-          auto eventLoop = context->getEventLoop();
           context->setDeviceState(State::INFO);
-          ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0,
-                                            &event, sizeof(event),
-                                            portMAX_DELAY));
-          // 定时器, 5秒后,退出IP展示
-          esp_timer_handle_t timer;
+          context->postEvent(event);
+          // 定时器, 5秒后,退出IP展示. 只创建一次, 重复点击时重新计时
+          static esp_timer_handle_t timer = nullptr;
+          if (timer != nullptr) {
+            esp_timer_stop(timer);
+            esp_timer_start_once(timer, 5000000);
+            return;
+          }
           esp_timer_create_args_t timer_args = {
               .callback =
                   [](void *arg) {
@@ -95,9 +89,7 @@ void button::init(Context *context) {
         Event::Body event;
         event.type = Event::Type::BUTTON_LONG_PRESS;
         event.source = Event::Source::BUTTON;
-        auto eventLoop = context->getEventLoop();
-        ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0, &event,
-                                          sizeof(event), portMAX_DELAY));
+        context->postEvent(event);
       },
       ctx);
 }
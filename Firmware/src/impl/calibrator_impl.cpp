@@ -0,0 +1,513 @@
+#include <Arduino.h>
+#include <esp_log.h>
+#include <math.h>
+#include <mutex>
+
+#include "board.h"
+
+using namespace mcompass;
+
+static const char *TAG = "CALIBRATOR";
+
+// 设计向量 [x², y², z², 2xy, 2xz, 2yz, 2x, 2y, 2z] 的维数
+#define FIT_DIM 9
+// 法方程矩阵的上三角元素个数
+#define FIT_PAIRS (FIT_DIM * (FIT_DIM + 1) / 2)
+// 半径相对误差达到该值时拟合度为0
+#define FIT_MAX_RESIDUAL 0.1
+// 已应用结果的参考质量在每次求解时衰减, 环境变化后新的拟合最终可以替换它
+#define REFERENCE_QUALITY_DECAY 0.99f
+// 两次求解之间至少新采纳的采样数
+#define MIN_NEW_SAMPLES 20
+// 预热采样数: 只记录各轴范围, 中点作为归一化的参考点
+#define WARMUP_SAMPLES 32
+// 连续求解失败该次数后丢弃累加的数据重新开始(参考点可能不在椭球内部)
+#define MAX_FAILED_SOLVES 5
+
+/**
+ * 累加量. 采样先归一化为 (v - reference) / scale, 各项都在1附近,
+ * 法方程的条件数不会因为原始读数的量级变差.
+ * 方程右边为1, 不能表示经过原点的椭球, 参考点必须在椭球内部:
+ * 取预热阶段各轴范围的中点
+ */
+struct Accumulator {
+  double stepScale;  // 采纳采样的距离门限按第一个采样的幅值换算
+  int16_t last[3];   // 上一个采纳的采样
+  double low[3];     // 预热阶段各轴的范围
+  double high[3];
+  double reference[3];
+  double scale;
+  double dtd[FIT_PAIRS];
+  double dt1[FIT_DIM];
+  double weight;
+  uint32_t accepted;
+};
+
+static std::mutex accumulatorMutex;
+static Accumulator accumulator = {};
+
+// 求解结果在后台任务与传感器定时器之间传递
+static std::mutex resultMutex;
+static calibrator::Result pending;
+static bool hasPending = false;
+static calibrator::Result lastResult;
+static bool hasLast = false;
+// begin/end 时加一, 求解开始后变化的结果来自之前的数据, 直接丢弃
+static uint32_t epoch = 0;
+// 手动校准中; 本次校准是否得到了合格的结果; begin 之前的质量分, 取消时恢复
+static bool inSession = false;
+static bool sessionAccepted = false;
+static float previousReferenceQuality = 0;
+static float previousSavedQuality = 0;
+
+static calibrator::Stats calibratorStats = {};
+static uint32_t lastSolvedAccepted = 0;
+static uint32_t failedSolves = 0;
+// 以下两个质量分由 resultMutex 保护
+static float referenceQuality = 0;
+static float savedQuality = 0;
+static int64_t lastSaveTime = 0;
+static TaskHandle_t calibratorTask = nullptr;
+
+/**
+ * @brief 列主元高斯消元解 n 元线性方程组, m 为 n x (n+1) 增广矩阵, 会被修改
+ * @return 主元过小(方程奇异)时返回false
+ */
+static bool solveLinear(int n, double m[][FIT_DIM + 1], double x[]) {
+  double maxDiagonal = 0;
+  for (int i = 0; i < n; i++) {
+    maxDiagonal = fmax(maxDiagonal, fabs(m[i][i]));
+  }
+  for (int col = 0; col < n; col++) {
+    int pivot = col;
+    for (int row = col + 1; row < n; row++) {
+      if (fabs(m[row][col]) > fabs(m[pivot][col])) {
+        pivot = row;
+      }
+    }
+    if (fabs(m[pivot][col]) <= maxDiagonal * 1e-12) {
+      return false;
+    }
+    if (pivot != col) {
+      for (int k = col; k <= n; k++) {
+        double tmp = m[col][k];
+        m[col][k] = m[pivot][k];
+        m[pivot][k] = tmp;
+      }
+    }
+    for (int row = col + 1; row < n; row++) {
+      double factor = m[row][col] / m[col][col];
+      for (int k = col; k <= n; k++) {
+        m[row][k] -= factor * m[col][k];
+      }
+    }
+  }
+  for (int row = n - 1; row >= 0; row--) {
+    double sum = m[row][n];
+    for (int k = row + 1; k < n; k++) {
+      sum -= m[row][k] * x[k];
+    }
+    x[row] = sum / m[row][row];
+  }
+  return true;
+}
+
+/**
+ * @brief 雅可比法求3x3对称矩阵的特征值和特征向量(按列), a 会被修改
+ */
+static void eigenSymmetric(double a[3][3], double values[3],
+                           double vectors[3][3]) {
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      vectors[i][j] = i == j ? 1 : 0;
+    }
+  }
+  for (int sweep = 0; sweep < 32; sweep++) {
+    double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+    double diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+    if (off <= diagonal * 1e-24) {
+      break;
+    }
+    for (int p = 0; p < 2; p++) {
+      for (int q = p + 1; q < 3; q++) {
+        if (a[p][q] == 0) {
+          continue;
+        }
+        double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+        double t = (theta >= 0 ? 1 : -1) /
+                   (fabs(theta) + sqrt(theta * theta + 1));
+        double c = 1 / sqrt(t * t + 1);
+        double s = t * c;
+        for (int k = 0; k < 3; k++) {
+          double akp = a[k][p], akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (int k = 0; k < 3; k++) {
+          double apk = a[p][k], aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (int k = 0; k < 3; k++) {
+          double vkp = vectors[k][p], vkq = vectors[k][q];
+          vectors[k][p] = c * vkp - s * vkq;
+          vectors[k][q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    values[i] = a[i][i];
+  }
+}
+
+static float clamp01(double value) {
+  return value < 0 ? 0 : value > 1 ? 1 : (float)value;
+}
+
+static void calibratorLoop(void *) {
+  for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(CALIBRATOR_SOLVE_MS));
+    calibrator::process();
+  }
+}
+
+void calibrator::init(float quality) {
+  {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    savedQuality = quality;
+  }
+  lastSaveTime = esp_timer_get_time();
+  if (calibratorTask == nullptr) {
+    // 求解不赶时间, 优先级只比空闲任务高
+    xTaskCreate(calibratorLoop, "calibrator", 4096, nullptr,
+                tskIDLE_PRIORITY + 1, &calibratorTask);
+  }
+}
+
+void calibrator::reset() {
+  {
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    accumulator = {};
+  }
+  lastSolvedAccepted = 0;
+  failedSolves = 0;
+}
+
+void calibrator::begin() {
+  calibrator::reset();
+  std::lock_guard<std::mutex> lock(resultMutex);
+  epoch++;
+  hasLast = false;
+  hasPending = false;
+  if (!inSession) {
+    previousReferenceQuality = referenceQuality;
+    previousSavedQuality = savedQuality;
+  }
+  inSession = true;
+  sessionAccepted = false;
+  referenceQuality = 0;
+  savedQuality = 0;
+}
+
+void calibrator::end() {
+  std::lock_guard<std::mutex> lock(resultMutex);
+  if (!inSession) {
+    return;
+  }
+  inSession = false;
+  epoch++;
+  if (!sessionAccepted) {
+    referenceQuality = previousReferenceQuality;
+    savedQuality = previousSavedQuality;
+    hasPending = false;
+  }
+}
+
+float calibrator::progress() {
+  std::lock_guard<std::mutex> lock(resultMutex);
+  return hasLast ? lastResult.coverage : 0;
+}
+
+void calibrator::feed(const int16_t xyz[3]) {
+  std::lock_guard<std::mutex> lock(accumulatorMutex);
+  Accumulator &acc = accumulator;
+  if (acc.accepted == 0) {
+    double norm = 0;
+    for (int i = 0; i < 3; i++) {
+      norm += (double)xyz[i] * xyz[i];
+      acc.low[i] = acc.high[i] = xyz[i];
+    }
+    acc.stepScale = fmax(sqrt(norm), 64.0);
+  } else {
+    double step = 0;
+    for (int i = 0; i < 3; i++) {
+      double delta = (double)xyz[i] - acc.last[i];
+      step += delta * delta;
+    }
+    double minStep = CALIBRATOR_MIN_STEP * acc.stepScale;
+    if (step < minStep * minStep) {
+      return;
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    acc.last[i] = xyz[i];
+  }
+  acc.accepted++;
+
+  if (acc.accepted <= WARMUP_SAMPLES) {
+    double halfRange = 0;
+    for (int i = 0; i < 3; i++) {
+      acc.low[i] = fmin(acc.low[i], xyz[i]);
+      acc.high[i] = fmax(acc.high[i], xyz[i]);
+      acc.reference[i] = (acc.low[i] + acc.high[i]) / 2;
+      halfRange = fmax(halfRange, (acc.high[i] - acc.low[i]) / 2);
+    }
+    acc.scale = fmax(halfRange, 64.0);
+    return;
+  }
+
+  double u[3];
+  for (int i = 0; i < 3; i++) {
+    u[i] = (xyz[i] - acc.reference[i]) / acc.scale;
+  }
+
+  const double d[FIT_DIM] = {u[0] * u[0],     u[1] * u[1],     u[2] * u[2],
+                             2 * u[0] * u[1], 2 * u[0] * u[2], 2 * u[1] * u[2],
+                             2 * u[0],        2 * u[1],        2 * u[2]};
+  const double decay = 1.0 - 1.0 / CALIBRATOR_WINDOW;
+  int k = 0;
+  for (int i = 0; i < FIT_DIM; i++) {
+    for (int j = i; j < FIT_DIM; j++) {
+      acc.dtd[k] = acc.dtd[k] * decay + d[i] * d[j];
+      k++;
+    }
+    acc.dt1[i] = acc.dt1[i] * decay + d[i];
+  }
+  acc.weight = acc.weight * decay + 1;
+}
+
+bool calibrator::solve(Result &out) {
+  Accumulator acc;
+  {
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    acc = accumulator;
+  }
+  if (acc.weight < CALIBRATOR_MIN_SAMPLES) {
+    return false;
+  }
+
+  // 法方程 (DᵀD) p = Dᵀ1
+  double normal[FIT_DIM][FIT_DIM + 1];
+  int k = 0;
+  for (int i = 0; i < FIT_DIM; i++) {
+    for (int j = i; j < FIT_DIM; j++) {
+      normal[i][j] = normal[j][i] = acc.dtd[k++];
+    }
+    normal[i][FIT_DIM] = acc.dt1[i];
+  }
+  double p[FIT_DIM];
+  if (!solveLinear(FIT_DIM, normal, p)) {
+    return false;
+  }
+
+  // 中心 o 满足 A o = -g, 椭球化为 (u-o)ᵀ A (u-o) = 1 + oᵀAo
+  const double a[3][3] = {{p[0], p[3], p[4]}, {p[3], p[1], p[5]},
+                          {p[4], p[5], p[2]}};
+  double center[FIT_DIM][FIT_DIM + 1];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      center[i][j] = a[i][j];
+    }
+    center[i][3] = -p[6 + i];
+  }
+  double o[3];
+  if (!solveLinear(3, center, o)) {
+    return false;
+  }
+  double k0 = 1;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      k0 += o[i] * a[i][j] * o[j];
+    }
+  }
+  if (k0 <= 0) {
+    return false;
+  }
+
+  // 软磁矩阵 W = (A/k)^(1/2), 使 |W(u-o)| = 1
+  double q[3][3], values[3], vectors[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      q[i][j] = a[i][j] / k0;
+    }
+  }
+  eigenSymmetric(q, values, vectors);
+  for (int i = 0; i < 3; i++) {
+    if (values[i] <= 0) {
+      return false;
+    }
+    values[i] = sqrt(values[i]);
+  }
+  double w[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      w[i][j] = 0;
+      for (int m = 0; m < 3; m++) {
+        w[i][j] += vectors[i][m] * values[m] * vectors[j][m];
+      }
+    }
+  }
+
+  // 拟合度: 代数残差 1 - dᵀp = k(1 - |W(u-o)|²), 约为半径相对误差的 2k 倍.
+  // 在解处残差平方和为 n - pᵀ(Dᵀ1)
+  double explained = 0;
+  for (int i = 0; i < FIT_DIM; i++) {
+    explained += p[i] * acc.dt1[i];
+  }
+  double residual =
+      sqrt(fmax(acc.weight - explained, 0) / acc.weight) / (2 * k0);
+
+  // 覆盖度: 校准后单位向量的二阶矩 E[ssᵀ], 均匀覆盖整个球面时为 I/3
+  double mean[3], moment[3][3];
+  for (int i = 0; i < 3; i++) {
+    mean[i] = acc.dt1[6 + i] / (2 * acc.weight);
+    moment[i][i] = acc.dt1[i] / acc.weight;
+  }
+  moment[0][1] = moment[1][0] = acc.dt1[3] / (2 * acc.weight);
+  moment[0][2] = moment[2][0] = acc.dt1[4] / (2 * acc.weight);
+  moment[1][2] = moment[2][1] = acc.dt1[5] / (2 * acc.weight);
+  double centered[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      centered[i][j] =
+          moment[i][j] - mean[i] * o[j] - o[i] * mean[j] + o[i] * o[j];
+    }
+  }
+  double spread[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      spread[i][j] = 0;
+      for (int m = 0; m < 3; m++) {
+        for (int n = 0; n < 3; n++) {
+          spread[i][j] += w[i][m] * centered[m][n] * w[n][j];
+        }
+      }
+    }
+  }
+  double spreadValues[3], spreadVectors[3][3];
+  eigenSymmetric(spread, spreadValues, spreadVectors);
+  double minSpread =
+      fmin(spreadValues[0], fmin(spreadValues[1], spreadValues[2]));
+
+  // 换算回原始读数: u = (v - reference) / scale
+  for (int i = 0; i < 3; i++) {
+    out.offsets[i] = acc.reference[i] + acc.scale * o[i];
+    for (int j = 0; j < 3; j++) {
+      out.matrix[i][j] = w[i][j] / acc.scale;
+    }
+  }
+  out.coverage = clamp01(3 * minSpread);
+  out.residual = residual;
+  out.quality = out.coverage * clamp01(1 - residual / FIT_MAX_RESIDUAL);
+  out.samples = acc.weight;
+  return true;
+}
+
+void calibrator::process() {
+  uint32_t accepted;
+  double weight;
+  uint32_t solveEpoch;
+  {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    solveEpoch = epoch;
+  }
+  {
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    accepted = accumulator.accepted;
+    weight = accumulator.weight;
+  }
+  // 采样不足时不算求解失败
+  if (weight < CALIBRATOR_MIN_SAMPLES ||
+      accepted - lastSolvedAccepted < MIN_NEW_SAMPLES) {
+    return;
+  }
+  lastSolvedAccepted = accepted;
+
+  calibratorStats.solves++;
+  Result result;
+  if (!solve(result)) {
+    calibratorStats.failed++;
+    if (++failedSolves >= MAX_FAILED_SOLVES) {
+      ESP_LOGW(TAG, "fit keeps failing, restart");
+      calibrator::reset();
+    }
+    return;
+  }
+  failedSolves = 0;
+  int64_t now = esp_timer_get_time();
+  {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    if (epoch != solveEpoch) {
+      // 求解期间开始或结束了手动校准
+      return;
+    }
+    lastResult = result;
+    hasLast = true;
+
+    referenceQuality *= REFERENCE_QUALITY_DECAY;
+    if (result.quality < CALIBRATOR_MIN_QUALITY ||
+        result.quality < referenceQuality - 0.1f) {
+      return;
+    }
+    referenceQuality = result.quality;
+    pending = result;
+    hasPending = true;
+    sessionAccepted = inSession;
+    calibratorStats.applied++;
+
+    if (result.quality < savedQuality + 0.05f &&
+        now - lastSaveTime < (int64_t)CALIBRATOR_SAVE_INTERVAL_MS * 1000) {
+      return;
+    }
+    savedQuality = result.quality;
+  }
+  preference::CalibrationData data = {};
+  for (int i = 0; i < 3; i++) {
+    data.offsets[i] = result.offsets[i];
+    data.scales[i] = result.matrix[i][i];
+    for (int j = 0; j < 3; j++) {
+      data.matrix[i][j] = result.matrix[i][j];
+    }
+  }
+  data.quality = result.quality;
+  preference::setCalibration(data);
+  lastSaveTime = now;
+  calibratorStats.saved++;
+  ESP_LOGI(TAG, "saved offsets(%.1f, %.1f, %.1f) quality=%.2f",
+           result.offsets[0], result.offsets[1], result.offsets[2],
+           result.quality);
+}
+
+bool calibrator::take(Result &out) {
+  std::lock_guard<std::mutex> lock(resultMutex);
+  if (!hasPending) {
+    return false;
+  }
+  out = pending;
+  hasPending = false;
+  return true;
+}
+
+bool calibrator::last(Result &out) {
+  std::lock_guard<std::mutex> lock(resultMutex);
+  out = lastResult;
+  return hasLast;
+}
+
+calibrator::Stats calibrator::stats() {
+  calibrator::Stats result = calibratorStats;
+  std::lock_guard<std::mutex> lock(accumulatorMutex);
+  result.accepted = accumulator.accepted;
+  return result;
+}
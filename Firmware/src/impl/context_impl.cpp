@@ -1,10 +1,46 @@
 #include "context.h"
 
 #include "IState.h"
+#include "metrics_def.h"
+#include "source_def.h"
+#include "states/StateTable.h"
 #include "utils.h"
 
 using namespace mcompass;
 
+template <typename Fn> void Context::publish(Fn update) {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  uint32_t version = m_version.load(std::memory_order_relaxed);
+  ContextSnapshot &next = m_shared[(version + 1) & 1];
+  next = m_shared[version & 1];
+  update(next);
+  // 切换版本号之后读取方才会看到新缓冲
+  m_version.store(version + 1, std::memory_order_release);
+}
+
+template <typename T> T Context::readShared(T ContextSnapshot::*field) const {
+  T value;
+  uint32_t version;
+  do {
+    version = m_version.load(std::memory_order_acquire);
+    value = m_shared[version & 1].*field;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // 读取期间有写入方发布过, 正在读的缓冲可能已被改写, 重读
+  } while (m_version.load(std::memory_order_relaxed) != version);
+  return value;
+}
+
+ContextSnapshot Context::snapshot() const {
+  ContextSnapshot snap;
+  uint32_t version;
+  do {
+    version = m_version.load(std::memory_order_acquire);
+    snap = m_shared[version & 1];
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (m_version.load(std::memory_order_relaxed) != version);
+  return snap;
+}
+
 void Context::setModel(Model model) { this->model = model; }
 
 Model Context::getModel() const { return model; }
@@ -13,18 +49,31 @@ bool Context::isModel(const Model model) { return this->model == model; }
 
 bool Context::isGPSModel() { return this->isModel(mcompass::Model::GPS); }
 
-State Context::getDeviceState() const { return deviceState; }
-void Context::setDeviceState(State state) { deviceState = state; }
+State Context::getDeviceState() const {
+  return readShared(&ContextSnapshot::deviceState);
+}
+void Context::setDeviceState(State state) {
+  publish([state](ContextSnapshot &shared) { shared.deviceState = state; });
+  source::update();
+}
 
 State Context::getLastDeviceState() const { return lastDeviceState; }
 void Context::setLastDeviceState(State state) { lastDeviceState = state; }
 
-WorkType Context::getWorkType() const { return workType; }
-void Context::setWorkType(WorkType wt) { workType = wt; }
+WorkType Context::getWorkType() const {
+  return readShared(&ContextSnapshot::workType);
+}
+void Context::setWorkType(WorkType wt) {
+  publish([wt](ContextSnapshot &shared) { shared.workType = wt; });
+  source::update();
+}
 void Context::toggleWorkType() {
-  setWorkType(workType == mcompass::WorkType::SPAWN
-                  ? mcompass::WorkType::SOUTH
-                  : mcompass::WorkType::SPAWN);
+  publish([](ContextSnapshot &shared) {
+    shared.workType = shared.workType == mcompass::WorkType::SPAWN
+                          ? mcompass::WorkType::SOUTH
+                          : mcompass::WorkType::SPAWN;
+  });
+  source::update();
 }
 
 bool Context::getDetectGPS() const { return detectGPS; }
@@ -36,43 +85,87 @@ void Context::setSensorModel(SensorModel sm) { sensorModel = sm; }
 bool Context::getHasSensor() const { return hasSensor; }
 void Context::setHasSensor(bool sensor) { hasSensor = sensor; }
 
-PointerColor Context::getColor() const { return color; }
-void Context::setColor(PointerColor c) { color = c; }
+PointerColor Context::getColor() const {
+  return readShared(&ContextSnapshot::color);
+}
+void Context::setColor(PointerColor c) {
+  publish([&c](ContextSnapshot &shared) { shared.color = c; });
+}
 
-Location Context::getCurrentLocation() const { return currentLoc; }
-void Context::setCurrentLocation(const Location &loc) { currentLoc = loc; }
+Location Context::getCurrentLocation() const {
+  return readShared(&ContextSnapshot::currentLocation);
+}
+void Context::setCurrentLocation(const Location &loc) {
+  publish([&loc](ContextSnapshot &shared) { shared.currentLocation = loc; });
+}
 
-Location Context::getSpawnLocation() const { return spawnLocation; }
-void Context::setSpawnLocation(const Location &loc) { spawnLocation = loc; }
+Location Context::getSpawnLocation() const {
+  return readShared(&ContextSnapshot::spawnLocation);
+}
+void Context::setSpawnLocation(const Location &loc) {
+  publish([&loc](ContextSnapshot &shared) { shared.spawnLocation = loc; });
+}
 
 ServerMode Context::getServerMode() const { return serverMode; }
 void Context::setServerMode(ServerMode mode) { serverMode = mode; }
 
-uint8_t Context::getBrightness() const { return brightness; }
-void Context::setBrightness(uint8_t bright) { brightness = bright; }
+uint8_t Context::getBrightness() const {
+  return readShared(&ContextSnapshot::brightness);
+}
+void Context::setBrightness(uint8_t bright) {
+  publish([bright](ContextSnapshot &shared) { shared.brightness = bright; });
+}
 
-String Context::getSsid() const { return ssid; }
-void Context::setSsid(const String &id) { ssid = id; }
+String Context::getSsid() const {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  return ssid;
+}
+void Context::setSsid(const String &id) {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  ssid = id;
+}
 
-String Context::getPassword() const { return password; }
-void Context::setPassword(const String &pass) { password = pass; }
+String Context::getPassword() const {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  return password;
+}
+void Context::setPassword(const String &pass) {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  password = pass;
+}
 
-Event::Source Context::getSubscribeSource() const { return subscribeSource; }
-void Context::setSubscribeSource(Event::Source src) { subscribeSource = src; }
+Event::Source Context::getSubscribeSource() const {
+  return readShared(&ContextSnapshot::subscribeSource);
+}
+void Context::setSubscribeSource(Event::Source src) {
+  publish([src](ContextSnapshot &shared) { shared.subscribeSource = src; });
+  source::update();
+}
 
-int Context::getAzimuth() const { return azimuth; }
-void Context::setAzimuth(int azi) {
+angle::Centideg Context::getAzimuth() const { return azimuth; }
+void Context::setAzimuth(angle::Centideg azi) {
   setLastAzimuth(azimuth);
   azimuth = azi;
 }
 
-int Context::getLastAzimuth() const { return lastAzimuth; }
-void Context::setLastAzimuth(int azi) { lastAzimuth = azi; }
+angle::Centideg Context::getLastAzimuth() const { return lastAzimuth; }
+void Context::setLastAzimuth(angle::Centideg azi) { lastAzimuth = azi; }
 
 esp_event_loop_handle_t Context::getEventLoop() { return eventLoop; }
 
 void Context::setEventLoop(esp_event_loop_handle_t loop) { eventLoop = loop; }
 
+esp_err_t Context::postEvent(const Event::Body &event) {
+  esp_err_t err = metrics::postEvent(eventLoop, event,
+                                     pdMS_TO_TICKS(CONTROL_EVENT_TIMEOUT_MS));
+  if (err != ESP_OK) {
+    ESP_LOGW("Context", "Drop event %s from %s: %s",
+             Event::TypeToString(event.type),
+             Event::SourceToString(event.source), esp_err_to_name(err));
+  }
+  return err;
+}
+
 void Context::logSelf(char *buffer) {
   sprintf(buffer,
           "{\n "
@@ -85,30 +178,79 @@ void Context::logSelf(char *buffer) {
           this->getServerMode(), this->getColor().spawnColor,
           this->getColor().southColor, this->getBrightness(),
           this->getSpawnLocation().latitude, this->getSpawnLocation().longitude,
-          this->getSsid(), this->getModel() == Model::GPS ? "GPS" : "LITE",
+          this->getSsid().c_str(), this->getModel() == Model::GPS ? "GPS" : "LITE",
           this->getHasSensor(),
           utils::sensorModel2Str(this->getSensorModel()).c_str(),
           this->getDetectGPS());
 }
 
-void Context::setIsGPSFixed(bool isFixed) { isGPSFixed = isFixed; }
-bool Context::getIsGPSFixed() const { return isGPSFixed; }
+void Context::setIsGPSFixed(bool isFixed) {
+  bool changed = false;
+  publish([isFixed, &changed](ContextSnapshot &shared) {
+    changed = shared.gpsFixed != isFixed;
+    shared.gpsFixed = isFixed;
+  });
+  if (changed) {
+    source::update();
+  }
+}
+bool Context::getIsGPSFixed() const {
+  return readShared(&ContextSnapshot::gpsFixed);
+}
 
-void Context::setState(IState *newState) {
-  if (m_currentState != nullptr) {
-    ESP_LOGI("Context", "Exiting state: %s", m_currentState->getName());
-    m_currentState->onExit(*this);
-    delete m_currentState; // 删除旧状态对象
+void Context::setState(StateId id, int8_t trigger) {
+  IState *newState = states::get(id);
+  if (newState == nullptr) {
+    return;
+  }
+  IState *oldState = states::get(m_stateId);
+  StateTransition &record = m_trace[m_traceCount % STATE_TRACE_SIZE];
+  record = {(uint32_t)millis(), m_stateId, id, trigger};
+  m_traceCount++;
+
+  if (oldState != nullptr) {
+    ESP_LOGI("Context", "Exiting state: %s", oldState->getName());
+    oldState->onExit(*this);
   }
 
-  m_currentState = newState;
+  m_stateId = id;
+
+  ESP_LOGI("Context", "Entering state: %s", newState->getName());
+  newState->onEnter(*this);
+}
+
+StateId Context::getStateId() const { return m_stateId; }
 
-  if (m_currentState != nullptr) {
-    ESP_LOGI("Context", "Entering state: %s", m_currentState->getName());
-    m_currentState->onEnter(*this);
+IState *Context::getCurrentState() { return states::get(m_stateId); }
+
+void Context::logTransitions(char *buffer, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  buffer[0] = '\0';
+  uint32_t count = min<uint32_t>(m_traceCount, STATE_TRACE_SIZE);
+  size_t len = 0;
+  for (uint32_t i = m_traceCount - count; i < m_traceCount && len < size;
+       i++) {
+    const StateTransition &record = m_trace[i % STATE_TRACE_SIZE];
+    len += snprintf(buffer + len, size - len, "%s%u:%s->%s(%s)",
+                    len > 0 ? ";" : "", (unsigned)record.timestamp,
+                    states::name(record.from), states::name(record.to),
+                    record.trigger < 0 ? "-"
+                                       : Event::TypeToString(
+                                             (Event::Type)record.trigger));
   }
 }
 
-IState *Context::getCurrentState() { return m_currentState; }
+void Context::handleEvent(Event::Body *evt) {
+  uint32_t start = metrics::now();
+  StateId next;
+  if (states::findTransition(m_stateId, evt->type, next)) {
+    setState(next, (int8_t)evt->type);
+  } else if (IState *state = states::get(m_stateId)) {
+    state->handleEvent(*this, evt);
+  }
+  metrics::dispatched(*evt, start);
+}
 
 
@@ -1,6 +1,8 @@
 #include "event.h"
 using namespace Event;
 
+ESP_EVENT_DEFINE_BASE(MCOMPASS_EVENT);
+
 const char* Event::SourceToString(Source source) {
   switch (source) {
     case Source::BUTTON:
@@ -15,6 +17,8 @@ const char* Event::SourceToString(Source source) {
       return "BLE";
     case Source::OTHER:
       return "Other";
+    case Source::NETHER:
+      return "Nether";
     default:
       return "Unknown Source";
   }
@@ -26,6 +30,18 @@ const char* Event::TypeToString(Type type) {
       return "AZIMUTH";
     case Type::TEXT:
       return "TEXT";
+    case Type::BUTTON_CLICK:
+      return "BUTTON_CLICK";
+    case Type::BUTTON_LONG_PRESS:
+      return "BUTTON_LONG_PRESS";
+    case Type::BUTTON_MULTI_CLICK:
+      return "BUTTON_MULTI_CLICK";
+    case Type::SENSOR_CALIBRATE:
+      return "SENSOR_CALIBRATE";
+    case Type::FACTORY_RESET:
+      return "FACTORY_RESET";
+    case Type::CALIBRATION_DONE:
+      return "CALIBRATION_DONE";
     default:
       return "Unknown EventType";
   }
@@ -173,6 +173,10 @@ void gps::init(Context *context) {
   nmea_hdl = nmea_parser_init(&config);
   /* register event handler for NMEA parser library */
   nmea_parser_add_handler(nmea_hdl, gps_event_handler, context);
+  // 记录原始NMEA数据
+  nmea_parser_set_line_callback(nmea_hdl, [](const char *line, size_t len) {
+    trace::recordNmea(line, len);
+  });
   // 检测不到GPS, 关闭GPS的Timer
   esp_timer_handle_t gpsDisableTimer;
   esp_timer_create_args_t gpsDisableTimerArgs = {
@@ -200,13 +204,24 @@ void gps::init(Context *context) {
  * @brief GPS 关闭
  */
 void gps::disable() {
+  if (nmea_hdl == NULL) {
+    return;
+  }
   /* unregister event handler */
   nmea_parser_remove_handler(nmea_hdl, gps_event_handler);
   /* deinit NMEA parser library */
   nmea_parser_deinit(nmea_hdl);
+  nmea_hdl = NULL;
   digitalWrite(GPS_EN_PIN, HIGH);
 }
 
+bool gps::feed(const char *line, size_t len) {
+  if (nmea_hdl == NULL) {
+    return false;
+  }
+  return nmea_parser_feed(nmea_hdl, line, len) == ESP_OK;
+}
+
 bool gps::isValidGPSLocation(Location location) {
   if (location.latitude >= -90 && location.latitude <= 90 &&
       location.longitude >= -180 && location.longitude <= 180) {
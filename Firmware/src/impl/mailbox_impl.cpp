@@ -0,0 +1,49 @@
+#include <Arduino.h>
+#include <atomic>
+
+#include "board.h"
+
+using namespace mcompass;
+
+#define SOURCE_COUNT (Event::Source::NETHER + 1)
+
+// 高16位序号从1开始, 槽位为0表示从未写入
+static std::atomic<uint32_t> slots[SOURCE_COUNT];
+
+static inline uint16_t seqOf(uint32_t word) { return word >> 16; }
+static inline angle::Centideg angleOf(uint32_t word) { return word & 0xFFFF; }
+
+void mailbox::publish(Event::Source source, angle::Centideg angle) {
+  if (static_cast<size_t>(source) >= SOURCE_COUNT) {
+    return;
+  }
+  // [0, 36000) 放得进低16位
+  uint16_t value = angle::normalize(angle);
+  std::atomic<uint32_t> &slot = slots[source];
+  uint32_t old = slot.load(std::memory_order_relaxed);
+  uint32_t word;
+  do {
+    uint16_t seq = seqOf(old) + 1;
+    if (seq == 0) {
+      seq = 1;
+    }
+    word = ((uint32_t)seq << 16) | value;
+  } while (!slot.compare_exchange_weak(old, word, std::memory_order_release,
+                                       std::memory_order_relaxed));
+}
+
+bool mailbox::read(Event::Source source, angle::Centideg &angle,
+                   uint16_t *seq) {
+  if (static_cast<size_t>(source) >= SOURCE_COUNT) {
+    return false;
+  }
+  uint32_t word = slots[source].load(std::memory_order_acquire);
+  if (seqOf(word) == 0) {
+    return false;
+  }
+  angle = angleOf(word);
+  if (seq != nullptr) {
+    *seq = seqOf(word);
+  }
+  return true;
+}
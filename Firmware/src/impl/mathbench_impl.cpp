@@ -0,0 +1,84 @@
+#include <math.h>
+#include <stdio.h>
+
+#include "board.h"
+#include "FixedMath.h"
+
+using namespace mcompass;
+
+// 基准测试用的校准参数, 浮点与定点版本相同
+static const float kOffset[2] = {123.5f, -87.25f};
+static const float kScale[2] = {6.1e-4f, 6.4e-4f};
+
+// 防止循环被优化掉
+static volatile int32_t sink;
+
+int32_t mathbench::headingFloat(int x, int y) {
+  float degrees = atan2f((y - kOffset[1]) * kScale[1],
+                         (x - kOffset[0]) * kScale[0]) *
+                  (float)(180.0 / M_PI);
+  int32_t centideg = (int32_t)floorf(degrees * 100.0f + 0.5f) % 36000;
+  return centideg < 0 ? centideg + 36000 : centideg;
+}
+
+int32_t mathbench::headingFixed(int x, int y) {
+  // 偏移为4位小数, 与滤波输出相同
+  const int32_t offset[2] = {(int32_t)(kOffset[0] * 16),
+                             (int32_t)(kOffset[1] * 16)};
+  const int32_t scale[2] = {fixed::fromFloat(kScale[0], 24),
+                            fixed::fromFloat(kScale[1], 24)};
+  int64_t X = (int64_t)(x * 16 - offset[0]) * scale[0];
+  int64_t Y = (int64_t)(y * 16 - offset[1]) * scale[1];
+  return fixed::wrapCentideg(fixed::atan2Centideg(Y, X));
+}
+
+float mathbench::springFloat(float target) {
+  static float azimuth = 0, velocity = 0;
+  float difference = target - azimuth;
+  if (difference > 180.0f) {
+    difference -= 360.0f;
+  } else if (difference < -180.0f) {
+    difference += 360.0f;
+  }
+  velocity += (60.0f * difference - 6.0f * velocity) / 60.0f;
+  azimuth = fmod(azimuth + velocity / 60.0f, 360.0f);
+  if (azimuth < 0.0f) {
+    azimuth += 360.0f;
+  }
+  return azimuth;
+}
+
+/// 运行 iterations 次, 返回单次平均周期数
+template <typename Fn> static uint32_t cyclesPerCall(int iterations, Fn fn) {
+  uint32_t start = metrics::now();
+  for (int i = 0; i < iterations; i++) {
+    fn(i);
+  }
+  return (metrics::now() - start) / iterations;
+}
+
+size_t mathbench::toJson(char *buffer, size_t size, int iterations) {
+  if (iterations <= 0) {
+    return 0;
+  }
+  uint32_t headingFloatCycles = cyclesPerCall(iterations, [](int i) {
+    sink = headingFloat(1200 - (i % 2400), (i * 37) % 2400 - 1200);
+  });
+  uint32_t headingFixedCycles = cyclesPerCall(iterations, [](int i) {
+    sink = headingFixed(1200 - (i % 2400), (i * 37) % 2400 - 1200);
+  });
+  uint32_t springFloatCycles = cyclesPerCall(iterations, [](int i) {
+    sink = (int32_t)springFloat((i * 7) % 360);
+  });
+  spring::State state;
+  // 帧间隔与60Hz渲染相同
+  uint32_t springFixedCycles = cyclesPerCall(iterations, [&state](int i) {
+    sink = spring::update(state, (i * 701) % angle::FULL_TURN, 16667);
+  });
+  size_t len = snprintf(
+      buffer, size,
+      "{\"iterations\":%d,\"heading\":[%u,%u],\"spring\":[%u,%u]}", iterations,
+      (unsigned)headingFloatCycles, (unsigned)headingFixedCycles,
+      (unsigned)springFloatCycles, (unsigned)springFixedCycles);
+  return len < size ? len : 0;
+}
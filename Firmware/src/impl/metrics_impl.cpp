@@ -0,0 +1,320 @@
+#include <Arduino.h>
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+
+using namespace mcompass;
+static const char *TAG = "METRICS";
+
+// 对数分桶: 小于8的值各占一桶, 其余按最高位分组, 每组再细分4桶,
+// 相对误差不超过25%
+#define BUCKET_COUNT 124
+
+struct StageStats {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint32_t buckets[BUCKET_COUNT];
+};
+
+static const char *stageNames[] = {"i2c",   "math", "spring", "post",
+                                   "disp",  "frame", "led",   "render"};
+static_assert(sizeof(stageNames) / sizeof(stageNames[0]) ==
+                  static_cast<size_t>(metrics::Stage::COUNT),
+              "stageNames out of sync with metrics::Stage");
+
+static const char *bootMarkNames[] = {"board", "probed", "sensor", "server",
+                                      "first_frame"};
+static_assert(sizeof(bootMarkNames) / sizeof(bootMarkNames[0]) ==
+                  static_cast<size_t>(metrics::BootMark::COUNT),
+              "bootMarkNames out of sync with metrics::BootMark");
+
+#define SOURCE_COUNT (Event::Source::NETHER + 1)
+#define TYPE_COUNT (static_cast<size_t>(Event::Type::CALIBRATION_DONE) + 1)
+
+struct SourceStats {
+  uint32_t posted;
+  uint32_t dropped;
+  uint32_t timedOut;
+};
+
+struct DispatchStats {
+  uint32_t count;
+  uint32_t max;
+  uint64_t sum;
+};
+
+static const char *sourceNames[] = {"button", "sensor", "web",   "ble",
+                                    "gps",    "other",  "nether"};
+static_assert(sizeof(sourceNames) / sizeof(sourceNames[0]) == SOURCE_COUNT,
+              "sourceNames out of sync with Event::Source");
+static const char *typeNames[] = {"azimuth", "text",  "click", "long",
+                                  "multi",   "calib", "reset", "calib_done"};
+static_assert(sizeof(typeNames) / sizeof(typeNames[0]) == TYPE_COUNT,
+              "typeNames out of sync with Event::Type");
+
+// 固定大小的统计内存块, 不做动态分配
+static StageStats stats[static_cast<size_t>(metrics::Stage::COUNT)];
+static SourceStats sourceStats[SOURCE_COUNT];
+static DispatchStats dispatchStats[TYPE_COUNT];
+static uint32_t framesWritten;
+static uint32_t framesSkipped;
+static uint32_t framesLate;
+static uint32_t ledsSent;
+static uint32_t ledsUnchanged;
+// 各启动时间点自开机的微秒数, 0 表示尚未到达
+static int64_t bootMarks[static_cast<size_t>(metrics::BootMark::COUNT)];
+// 已投递但尚未分发完成的事件数, 投递方和事件循环在不同任务中
+static std::atomic<uint32_t> queueDepth;
+static std::atomic<uint32_t> queueHighWater;
+
+static inline uint32_t bucketOf(uint32_t value) {
+  if (value < 8) {
+    return value;
+  }
+  uint32_t msb = 31 - __builtin_clz(value);
+  return 8 + (msb - 3) * 4 + ((value >> (msb - 2)) & 3);
+}
+
+/// 桶内的最大值
+static uint32_t bucketUpperBound(uint32_t bucket) {
+  if (bucket < 8) {
+    return bucket;
+  }
+  uint32_t msb = (bucket - 8) / 4 + 3;
+  uint32_t sub = (bucket - 8) % 4;
+  uint64_t lower = (uint64_t)(4 | sub) << (msb - 2);
+  return (uint32_t)(lower + (1ULL << (msb - 2)) - 1);
+}
+
+void metrics::record(Stage stage, uint32_t startCycles) {
+  uint32_t cycles = now() - startCycles;
+  StageStats &s = stats[static_cast<size_t>(stage)];
+  if (s.count == 0 || cycles < s.min) {
+    s.min = cycles;
+  }
+  if (cycles > s.max) {
+    s.max = cycles;
+  }
+  s.count++;
+  s.sum += cycles;
+  s.buckets[bucketOf(cycles)]++;
+}
+
+esp_err_t metrics::postEvent(esp_event_loop_handle_t loop,
+                             const Event::Body &event, TickType_t ticksToWait) {
+  uint32_t start = now();
+  // 先占位再投递, 避免事件循环在计数前就完成分发导致深度下溢
+  uint32_t depth = queueDepth.fetch_add(1) + 1;
+  esp_err_t err = esp_event_post_to(loop, MCOMPASS_EVENT, 0, &event,
+                                    sizeof(event), ticksToWait);
+  record(Stage::EVENT_POST, start);
+  SourceStats *s = static_cast<size_t>(event.source) < SOURCE_COUNT
+                       ? &sourceStats[event.source]
+                       : nullptr;
+  if (err != ESP_OK) {
+    queueDepth.fetch_sub(1);
+    if (s != nullptr) {
+      if (err == ESP_ERR_TIMEOUT && ticksToWait != 0) {
+        s->timedOut++;
+      } else {
+        s->dropped++;
+      }
+    }
+    return err;
+  }
+  if (s != nullptr) {
+    s->posted++;
+  }
+  uint32_t highWater = queueHighWater.load();
+  while (depth > highWater &&
+         !queueHighWater.compare_exchange_weak(highWater, depth)) {
+  }
+  return err;
+}
+
+void metrics::dispatched(const Event::Body &event, uint32_t startCycles) {
+  uint32_t cycles = now() - startCycles;
+  record(Stage::DISPATCH, startCycles);
+  uint32_t depth = queueDepth.load();
+  while (depth > 0 && !queueDepth.compare_exchange_weak(depth, depth - 1)) {
+  }
+  size_t type = static_cast<size_t>(event.type);
+  if (type >= TYPE_COUNT) {
+    return;
+  }
+  DispatchStats &d = dispatchStats[type];
+  d.count++;
+  d.sum += cycles;
+  if (cycles > d.max) {
+    d.max = cycles;
+  }
+}
+
+void metrics::recordFrame(bool written, uint32_t startCycles,
+                          uint32_t budgetCycles) {
+  uint32_t cycles = now() - startCycles;
+  record(Stage::RENDER, startCycles);
+  if (written) {
+    if (framesWritten == 0) {
+      bootMark(BootMark::FIRST_FRAME);
+    }
+    framesWritten++;
+  } else {
+    framesSkipped++;
+  }
+  if (cycles > budgetCycles) {
+    framesLate++;
+  }
+}
+
+void metrics::recordTransmit(bool sent) {
+  if (sent) {
+    ledsSent++;
+  } else {
+    ledsUnchanged++;
+  }
+}
+
+void metrics::bootMark(BootMark mark) {
+  int64_t &at = bootMarks[static_cast<size_t>(mark)];
+  if (at != 0) {
+    return;
+  }
+  // 虚拟时钟可能从0开始, 至少记为1微秒
+  at = max(esp_timer_get_time(), (int64_t)1);
+  if (mark == BootMark::FIRST_FRAME) {
+    ESP_LOGI(TAG, "boot to first frame %lld ms", (long long)(at / 1000));
+  }
+}
+
+void metrics::reset() {
+  framesWritten = framesSkipped = framesLate = 0;
+  ledsSent = ledsUnchanged = 0;
+  memset(stats, 0, sizeof(stats));
+  memset(sourceStats, 0, sizeof(sourceStats));
+  memset(dispatchStats, 0, sizeof(dispatchStats));
+  queueHighWater = queueDepth.load();
+}
+
+static uint32_t percentile(const StageStats &s, uint32_t permille) {
+  if (s.count == 0) {
+    return 0;
+  }
+  uint64_t target = ((uint64_t)s.count * permille + 999) / 1000;
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += s.buckets[i];
+    if (seen >= target) {
+      return min(bucketUpperBound(i), s.max);
+    }
+  }
+  return s.max;
+}
+
+/**
+ * @brief 在 buffer[len] 处追加格式化的内容, 追加后至少留下 reserve 字节给结尾.
+ * 放不下时保持 len 和已有内容不变, 返回 false
+ */
+static bool append(char *buffer, size_t size, size_t &len, size_t reserve,
+                   const char *format, ...) {
+  if (len + reserve >= size) {
+    return false;
+  }
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buffer + len, size - len - reserve, format, args);
+  va_end(args);
+  if (n < 0 || len + n + reserve >= size) {
+    buffer[len] = '\0';
+    return false;
+  }
+  len += n;
+  return true;
+}
+
+// 结尾的最大长度, 每个数值最多10位
+static const size_t kMetricsTailSize =
+    sizeof(",\"frames\":[,,],\"tx\":[,]}") - 1 + 5 * 10;
+static const size_t kEventsTailSize = sizeof("},\"type\":{}}") - 1;
+
+size_t metrics::toJson(char *buffer, size_t size) {
+  size_t len = 0;
+  if (!append(buffer, size, len, kMetricsTailSize, "{\"mhz\":%d",
+              (int)(F_CPU / 1000000))) {
+    return 0;
+  }
+  for (size_t i = 0; i < static_cast<size_t>(Stage::COUNT); i++) {
+    const StageStats &s = stats[i];
+    if (!append(buffer, size, len, kMetricsTailSize,
+                ",\"%s\":[%u,%u,%u,%u,%u]", stageNames[i], (unsigned)s.count,
+                (unsigned)s.min, (unsigned)(s.count ? s.sum / s.count : 0),
+                (unsigned)percentile(s, 990), (unsigned)s.max)) {
+      break;
+    }
+  }
+  if (!append(buffer, size, len, 0, ",\"frames\":[%u,%u,%u],\"tx\":[%u,%u]}",
+              (unsigned)framesWritten, (unsigned)framesSkipped,
+              (unsigned)framesLate, (unsigned)ledsSent,
+              (unsigned)ledsUnchanged)) {
+    return 0;
+  }
+  return len;
+}
+
+size_t metrics::eventsToJson(char *buffer, size_t size) {
+  size_t len = 0;
+  if (!append(buffer, size, len, kEventsTailSize,
+              "{\"depth\":%u,\"hwm\":%u,\"src\":{",
+              (unsigned)queueDepth.load(), (unsigned)queueHighWater.load())) {
+    return 0;
+  }
+  bool first = true;
+  for (size_t i = 0; i < SOURCE_COUNT; i++) {
+    const SourceStats &s = sourceStats[i];
+    if (s.posted == 0 && s.dropped == 0 && s.timedOut == 0) {
+      continue;
+    }
+    if (!append(buffer, size, len, kEventsTailSize, "%s\"%s\":[%u,%u,%u]",
+                first ? "" : ",", sourceNames[i], (unsigned)s.posted,
+                (unsigned)s.dropped, (unsigned)s.timedOut)) {
+      break;
+    }
+    first = false;
+  }
+  // kEventsTailSize 已为这里和结尾留出空间
+  append(buffer, size, len, 0, "},\"type\":{");
+  first = true;
+  for (size_t i = 0; i < TYPE_COUNT; i++) {
+    const DispatchStats &d = dispatchStats[i];
+    if (d.count == 0) {
+      continue;
+    }
+    if (!append(buffer, size, len, 2, "%s\"%s\":[%u,%u,%u]",
+                first ? "" : ",", typeNames[i], (unsigned)d.count,
+                (unsigned)(d.sum / d.count), (unsigned)d.max)) {
+      break;
+    }
+    first = false;
+  }
+  append(buffer, size, len, 0, "}}");
+  return len;
+}
+
+size_t metrics::bootToJson(char *buffer, size_t size) {
+  size_t len = snprintf(buffer, size, "{");
+  for (size_t i = 0; i < static_cast<size_t>(BootMark::COUNT) && len < size;
+       i++) {
+    len += snprintf(buffer + len, size - len, "%s\"%s\":%lld", i ? "," : "",
+                    bootMarkNames[i],
+                    bootMarks[i] ? (long long)(bootMarks[i] / 1000) : -1LL);
+  }
+  if (len < size) {
+    len += snprintf(buffer + len, size - len, "}");
+  }
+  return len < size ? len : 0;
+}
@@ -0,0 +1,112 @@
+#include <Arduino.h>
+#include <atomic>
+#include <esp_log.h>
+#include <mutex>
+
+#include "board.h"
+
+using namespace mcompass;
+
+static const char *TAG = "MOTION";
+
+// setPolicy 来自Web/BLE, feed 在采样完成回调中
+static std::mutex policyMutex;
+static motion::Policy policy = motion::defaultPolicy();
+
+// 最近 MOTION_WINDOW 个采样, 以及各轴的和与平方和
+static int16_t window[MOTION_WINDOW][3];
+static uint32_t windowCount = 0;
+static int64_t sum[3];
+static int64_t sumSquares[3];
+// 方差开始低于静止阈值的时间, -1 表示当前不低于
+static int64_t stillSince = -1;
+static std::atomic<bool> stationary{false};
+static motion::Stats motionStats = {};
+
+motion::Policy motion::defaultPolicy() {
+  return {MOTION_MOVE_THRESHOLD, MOTION_STILL_THRESHOLD, MOTION_STILL_MS,
+          MOTION_IDLE_HZ};
+}
+
+void motion::setPolicy(const Policy &next) {
+  std::lock_guard<std::mutex> lock(policyMutex);
+  // 静止阈值必须低于运动阈值, 否则会在两个状态之间来回切换
+  if (next.stillThreshold < next.moveThreshold) {
+    policy.moveThreshold = next.moveThreshold;
+    policy.stillThreshold = next.stillThreshold;
+  }
+  if (next.stillMs > 0) {
+    policy.stillMs = next.stillMs;
+  }
+  if (next.idleHz > 0 && next.idleHz <= DEFAULT_RENDER_FPS) {
+    policy.idleHz = next.idleHz;
+  }
+  ESP_LOGI(TAG, "policy move=%u still=%u stillMs=%u idleHz=%u",
+           (unsigned)policy.moveThreshold, (unsigned)policy.stillThreshold,
+           (unsigned)policy.stillMs, (unsigned)policy.idleHz);
+}
+
+motion::Policy motion::getPolicy() {
+  std::lock_guard<std::mutex> lock(policyMutex);
+  return policy;
+}
+
+void motion::reset() {
+  windowCount = 0;
+  memset(sum, 0, sizeof(sum));
+  memset(sumSquares, 0, sizeof(sumSquares));
+  stillSince = -1;
+  stationary = false;
+}
+
+bool motion::feed(const int16_t xyz[3], int64_t timestamp) {
+  int16_t *slot = window[windowCount % MOTION_WINDOW];
+  for (int i = 0; i < 3; i++) {
+    if (windowCount >= MOTION_WINDOW) {
+      sum[i] -= slot[i];
+      sumSquares[i] -= (int32_t)slot[i] * slot[i];
+    }
+    slot[i] = xyz[i];
+    sum[i] += xyz[i];
+    sumSquares[i] += (int32_t)xyz[i] * xyz[i];
+  }
+  windowCount++;
+  if (windowCount < MOTION_WINDOW) {
+    return false;
+  }
+  // 各轴方差 = (N * 平方和 - 和^2) / N^2
+  int64_t variance = 0;
+  for (int i = 0; i < 3; i++) {
+    variance += (MOTION_WINDOW * sumSquares[i] - sum[i] * sum[i]) /
+                (MOTION_WINDOW * MOTION_WINDOW);
+  }
+  motionStats.variance = variance > UINT32_MAX ? UINT32_MAX : (uint32_t)variance;
+
+  Policy current = getPolicy();
+  if (stationary) {
+    if (variance > current.moveThreshold) {
+      stillSince = -1;
+      stationary = false;
+      motionStats.wakes++;
+      return true;
+    }
+    return false;
+  }
+  if (variance >= current.stillThreshold) {
+    stillSince = -1;
+    return false;
+  }
+  if (stillSince < 0) {
+    stillSince = timestamp;
+  }
+  if (timestamp - stillSince < (int64_t)current.stillMs * 1000) {
+    return false;
+  }
+  stationary = true;
+  motionStats.idles++;
+  return true;
+}
+
+bool motion::isStationary() { return stationary; }
+
+motion::Stats motion::stats() { return motionStats; }
@@ -56,6 +56,7 @@ typedef struct {
     esp_event_loop_handle_t event_loop_hdl;        /*!< Event loop handle */
     TaskHandle_t tsk_hdl;                          /*!< NMEA Parser task handle */
     QueueHandle_t event_queue;                     /*!< UART event queue handle */
+    nmea_parser_line_cb_t line_cb;                 /*!< Raw line callback */
 } esp_gps_t;
 
 /**
@@ -578,6 +579,9 @@ static void esp_handle_uart_pattern(esp_gps_t *esp_gps)
         int read_len = uart_read_bytes(esp_gps->uart_port, esp_gps->buffer, pos + 1, 100 / portTICK_PERIOD_MS);
         /* make sure the line is a standard string */
         esp_gps->buffer[read_len] = '\0';
+        if (esp_gps->line_cb) {
+            esp_gps->line_cb((const char *)esp_gps->buffer, read_len);
+        }
         /* Send new line to handle */
         if (gps_decode(esp_gps, read_len + 1) != ESP_OK) {
             ESP_LOGW(GPS_TAG, "GPS decode line failed");
@@ -789,4 +793,44 @@ esp_err_t nmea_parser_remove_handler(nmea_parser_handle_t nmea_hdl, esp_event_ha
 {
     esp_gps_t *esp_gps = (esp_gps_t *)nmea_hdl;
     return esp_event_handler_unregister_with(esp_gps->event_loop_hdl, ESP_NMEA_EVENT, ESP_EVENT_ANY_ID, event_handler);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Set a callback which receives every raw line read from UART
+ *
+ * @param nmea_hdl handle of NMEA parser
+ * @param line_cb callback, NULL to disable
+ */
+void nmea_parser_set_line_callback(nmea_parser_handle_t nmea_hdl, nmea_parser_line_cb_t line_cb)
+{
+    esp_gps_t *esp_gps = (esp_gps_t *)nmea_hdl;
+    esp_gps->line_cb = line_cb;
+}
+
+/**
+ * @brief Decode one NMEA line as if it was read from UART, then drive the event loop
+ *
+ * @param nmea_hdl handle of NMEA parser
+ * @param line NMEA statement, the trailing "\r\n" is optional
+ * @param len length of line
+ * @return esp_err_t
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_SIZE: Line does not fit into the runtime buffer
+ */
+esp_err_t nmea_parser_feed(nmea_parser_handle_t nmea_hdl, const char *line, size_t len)
+{
+    esp_gps_t *esp_gps = (esp_gps_t *)nmea_hdl;
+    while (len > 0 && (line[len - 1] == '\r' || line[len - 1] == '\n')) {
+        len--;
+    }
+    if (len + 3 > NMEA_PARSER_RUNTIME_BUFFER_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(esp_gps->buffer, line, len);
+    esp_gps->buffer[len++] = '\r';
+    esp_gps->buffer[len++] = '\n';
+    esp_gps->buffer[len] = '\0';
+    esp_err_t err = gps_decode(esp_gps, len + 1);
+    esp_event_loop_run(esp_gps->event_loop_hdl, 0);
+    return err;
+}
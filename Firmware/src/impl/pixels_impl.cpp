@@ -1,18 +1,68 @@
 #include <FastLED.h>
+#include <atomic>
 
 #include "board.h"
 #include "compass_frames.h"
 #include "context.h"
 #include "font.h"
+#include "frame_lut.h"
 #include "utils.h"
 
 using namespace mcompass;
 
 static CRGB leds[NUM_LEDS];
+// 上一次输出到LED的内容和亮度, 未变化时跳过输出
+static CRGB sentLeds[NUM_LEDS];
+static int sentBrightness = -1;
 
 static const char *TAG = "PIXEL";
 
-static uint32_t pColor = DEFAULT_POINTER_COLOR;
+// Web任务和渲染任务都可能设置和使用, 解码时只读取一次
+static std::atomic<uint32_t> pColor(DEFAULT_POINTER_COLOR);
+
+static_assert(sizeof(frames) / sizeof(frames[0]) == MAX_FRAME_INDEX + 1,
+              "compass_frames.h does not match MAX_FRAME_INDEX");
+static_assert(sizeof(frames[0]) * 2 == NUM_LEDS,
+              "compass_frames.h does not match NUM_LEDS");
+
+
+/// LED缓冲或亮度与上一次输出不同时才调用 FastLED.show()
+static void transmit() {
+  uint8_t brightness = FastLED.getBrightness();
+  if (brightness == sentBrightness &&
+      memcmp(leds, sentLeds, sizeof(leds)) == 0) {
+    metrics::recordTransmit(false);
+    return;
+  }
+  uint32_t start = metrics::now();
+  FastLED.show();
+  metrics::record(metrics::Stage::LED_TRANSMIT, start);
+  memcpy(sentLeds, leds, sizeof(leds));
+  sentBrightness = brightness;
+  metrics::recordTransmit(true);
+}
+
+/// 按调色板把4位索引的帧解码到LED缓冲, 指针保持素材中的颜色
+static void decodeFrame(int index) {
+  const uint8_t *packed = frames[index];
+  for (int i = 0; i < NUM_LEDS; i += 2) {
+    leds[i] = framePalette[packed[i / 2] & 0x0F];
+    leds[i + 1] = framePalette[packed[i / 2] >> 4];
+  }
+}
+
+/// 用指针颜色覆盖帧中的指针像素
+static void paintPointer(int index, uint32_t color) {
+  uint64_t pointer = framePointerMasks[index];
+  for (int i = 0; pointer != 0; i++, pointer >>= 1) {
+    if (pointer & 1) {
+      leds[i] = color;
+    }
+  }
+}
+
+// 方位角到帧索引的查找表, 编译期生成
+static constexpr frame_lut::Table frameTable = frame_lut::build();
 
 // 屏幕布局定义
 const uint8_t mask[5][10] = {{0, 0, 1, 1, 1, 1, 1, 1, 1, 1},
@@ -59,16 +109,14 @@ void pixel::drawChar(char c, int startX, int startY, uint32_t color) {
   // 每个字符占3列
   for (int charCol = 0; charCol < 3; charCol++) {
     int screenCol = startX + charCol; // 计算屏幕上的列坐标
-    // if (screenCol < 0 || screenCol >= 10) {
-    //   ESP_LOGW(TAG, "skip screenCol < 0 || screenCol >= 10 %d,", screenCol);
-    //   continue;  // 列越界跳过
-    // }
+    if (screenCol < 0 || screenCol >= 10) {
+      continue; // 列越界跳过, 滚动时字符部分在屏幕外
+    }
     for (int charRow = 0; charRow < 5; charRow++) {
       int screenRow = startY + charRow; // 计算屏幕上的行坐标
-      // if (screenRow < 0 || screenRow >= 5) {
-      //   ESP_LOGW(TAG, "skip screenRow < 0 || screenRow >= 5 %d,", screenRow);
-      //   continue;  // 行越界跳过
-      // }
+      if (screenRow < 0 || screenRow >= 5) {
+        continue; // 行越界跳过
+      }
 
       // 检查mask和字库数据
       if (mask[screenRow][screenCol]) {
@@ -110,10 +158,8 @@ void pixel::theNether() {
   static int curIndex = 0;
   // 目标帧索引
   static int targetIndex = 0;
-  for (int i = 0; i < NUM_LEDS; i++) {
-    leds[i] = frames[curIndex][i];
-  }
-  FastLED.show();
+  decodeFrame(curIndex);
+  transmit();
   if (curIndex == targetIndex) {
     targetIndex = random(0, MAX_FRAME_INDEX);
   } else {
@@ -136,69 +182,60 @@ void pixel::showFrame(int index) {
     return;
   }
   // Serial.printf("showFrame: relative index=%f,", index);
-  static uint32_t color = 0;
-  for (int i = 0; i < NUM_LEDS; i++) {
-    leds[i] = frames[index][i] == DEFAULT_POINTER_COLOR ||
-                      frames[index][i] == 0xcb1a1a ||
-                      frames[index][i] == 0xbe1515
-                  ? pColor
-                  : frames[index][i];
-  }
-  FastLED.show();
+  uint32_t start = metrics::now();
+  decodeFrame(index);
+  paintPointer(index, pColor.load(std::memory_order_relaxed));
+  metrics::record(metrics::Stage::FRAME_LOOKUP, start);
+  transmit();
 }
 
-void pixel::showByAzimuth(float azimuth) {
-  if (azimuth < 0 || azimuth > 360) {
+void pixel::showByAzimuth(angle::Centideg azimuth) {
+  int index = indexByAzimuth(azimuth);
+  if (index < 0) {
     // 不响应不合法的方位角
     return;
   }
+  showFrame(index);
+}
 
-  // 原始素材中指针的方位角不是均匀分布的
-  // 去除高度重复帧后, 得到27帧不同的图像, 其中第N张图像对应
-  // 1 正上
-  // 8 正右
-  // 14 正下
-  // 21 正右
-  int index = 0;
-  // 较小的间距
-  float step_small = 90.0 / 7.0;
-  // 间距(90°~180°)
-  float step = 90.0 / 6.0;
-  if (azimuth < step_small * 6) {
-    // 90.0 / (8 - 1)
-    index = static_cast<int>(azimuth / step_small);
-  } else if (azimuth < 90 + step * 5) {
-    // 90.0 / (14 - 8)
-    index = 7 + static_cast<int>((azimuth - 90.0) / step);
-  } else if (azimuth < 180 + step_small * 6) {
-    // 90.0 / (21 - 14)
-    index = 13 + static_cast<int>((azimuth - 180.0) / step_small);
-  } else {
-    // 90.0 / (28 - 21)
-    index = 20 + static_cast<int>((azimuth - 270.0) / step_small);
+int pixel::indexByAzimuth(angle::Centideg azimuth, int previous) {
+  if (azimuth < 0 || azimuth > angle::FULL_TURN) {
+    return -1;
+  }
+  uint8_t entry = frameTable.entries[azimuth / 10 % frame_lut::kEntries];
+  int index = entry & frame_lut::kIndexMask;
+  // 刚越过边界时保持相邻的上一帧
+  if ((entry & frame_lut::kNearPrev) &&
+      previous == (index == 0 ? MAX_FRAME_INDEX : index - 1)) {
+    return previous;
+  }
+  if ((entry & frame_lut::kNearNext) &&
+      previous == (index == MAX_FRAME_INDEX ? 0 : index + 1)) {
+    return previous;
   }
+  return index;
+}
 
-  // 限制边界
-  index = min(MAX_FRAME_INDEX, index);
-  index = max(0, index);
-  showFrame(index);
+/// 目标方位角相对当前罗盘方位角的角度
+static angle::Centideg relativeAzimuth(float bearing,
+                                       angle::Centideg azimuth) {
+  return angle::normalize(azimuth - angle::fromDegrees(bearing));
 }
 
-void pixel::showFrameByBearing(float bearing, int azimuth) {
-  // 当前方位角对应的索引
-  int aIndex = (int)(azimuth / 360.0 * MAX_FRAME_INDEX);
-  // 目标方位角对应的索引
-  int bIndex = (int)(bearing / 360.0 * MAX_FRAME_INDEX);
-  // 计算差值
-  float degree = azimuth - bearing;
-  if (degree < 0) {
-    degree += 360;
-  }
-  showByAzimuth(degree);
+void pixel::showFrameByBearing(float bearing, angle::Centideg azimuth) {
+  showByAzimuth(relativeAzimuth(bearing, azimuth));
 }
 
 void pixel::showFrameByLocation(float latA, float lonA, float latB, float lonB,
-                                int azimuth) {
+                                angle::Centideg azimuth) {
+  int index = indexByLocation(latA, lonA, latB, lonB, azimuth);
+  if (index >= 0) {
+    showFrame(index);
+  }
+}
+
+int pixel::indexByLocation(float latA, float lonA, float latB, float lonB,
+                           angle::Centideg azimuth, int previous) {
   float bearing = utils::calculateBearing(latA, lonA, latB, lonB);
 
   // 由于我们的0度定义为正南方, 而calculateBearing是以正北方为0度计算的
@@ -209,12 +246,12 @@ void pixel::showFrameByLocation(float latA, float lonA, float latB, float lonB,
   }
   // ESP_LOGI(TAG, "showFrameByLocation: bearing=%f, azimuth=%d", bearing,
   //          azimuth);
-  showFrameByBearing(bearing, azimuth);
+  return indexByAzimuth(relativeAzimuth(bearing, azimuth), previous);
 }
 
 void pixel::showSolid(int color) {
   fill_solid(leds, NUM_LEDS, CRGB(color));
-  FastLED.show();
+  transmit();
 }
 
 static void showBouncing(int color) {
@@ -243,7 +280,7 @@ static void showBouncing(int color) {
     }
   }
   index += dir;
-  FastLED.show();
+  transmit();
 }
 
 void pixel::showServerWifi() {
@@ -265,18 +302,20 @@ void pixel::setBrightness(uint8_t brightness) {
   FastLED.setBrightness(brightness);
 }
 
-void pixel::setPointerColor(uint32_t pointColor) { pColor = pointColor; }
+void pixel::setPointerColor(uint32_t pointColor) {
+  pColor.store(pointColor, std::memory_order_relaxed);
+}
 
 void pixel::counterDown(int seconds) {
   for (int i = seconds; i >= 0; i--) {
     FastLED.clear();
     ESP_LOGI(TAG, "counterDown: %d", i);
     drawChar('0' + i, 4, 0, CRGB::Red);
-    FastLED.show();
+    transmit();
     delay(1000);
   }
 }
 
 void pixel::clear() { FastLED.clear(); }
 
-void pixel::show() { FastLED.show(); }
\ No newline at end of file
+void pixel::show() { transmit(); }
\ No newline at end of file
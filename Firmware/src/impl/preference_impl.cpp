@@ -200,4 +200,58 @@ preference::CalibrationData preference::getCalibration() {
   preferences.getBytes(CALIBRATION_KEY, &data, sizeof(preference::CalibrationData));
   preferences.end();
   return data;
-}
\ No newline at end of file
+}
+
+void preference::setSensorInfo(preference::SensorInfo info) {
+  Preferences preferences;
+  preferences.begin(PREFERENCE_NAME, false);
+  preferences.putBytes(SENSOR_KEY, &info, sizeof(preference::SensorInfo));
+  preferences.end();
+}
+
+preference::SensorInfo preference::getSensorInfo() {
+  Preferences preferences;
+  preferences.begin(PREFERENCE_NAME, true);
+  preference::SensorInfo info = {SensorModel::UNKNOWN, 0};
+  if (preferences.getBytesLength(SENSOR_KEY) == sizeof(preference::SensorInfo)) {
+    preferences.getBytes(SENSOR_KEY, &info, sizeof(preference::SensorInfo));
+  }
+  preferences.end();
+  return info;
+}
+
+void preference::setMotionPolicy(motion::Policy policy) {
+  Preferences preferences;
+  preferences.begin(PREFERENCE_NAME, false);
+  preferences.putBytes(MOTION_KEY, &policy, sizeof(motion::Policy));
+  preferences.end();
+}
+
+motion::Policy preference::getMotionPolicy() {
+  Preferences preferences;
+  preferences.begin(PREFERENCE_NAME, true);
+  motion::Policy policy = motion::defaultPolicy();
+  if (preferences.getBytesLength(MOTION_KEY) == sizeof(motion::Policy)) {
+    preferences.getBytes(MOTION_KEY, &policy, sizeof(motion::Policy));
+  }
+  preferences.end();
+  return policy;
+}
+
+void preference::setSpringParams(spring::Params params) {
+  Preferences preferences;
+  preferences.begin(PREFERENCE_NAME, false);
+  preferences.putBytes(SPRING_KEY, &params, sizeof(spring::Params));
+  preferences.end();
+}
+
+spring::Params preference::getSpringParams() {
+  Preferences preferences;
+  preferences.begin(PREFERENCE_NAME, true);
+  spring::Params params = spring::defaultParams();
+  if (preferences.getBytesLength(SPRING_KEY) == sizeof(spring::Params)) {
+    preferences.getBytes(SPRING_KEY, &params, sizeof(spring::Params));
+  }
+  preferences.end();
+  return params;
+}
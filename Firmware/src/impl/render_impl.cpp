@@ -0,0 +1,286 @@
+#include <Arduino.h>
+#include <esp_log.h>
+#include <mutex>
+
+#include "board.h"
+#include "context.h"
+
+using namespace mcompass;
+
+static const char *TAG = "RENDER";
+
+static TaskHandle_t renderTask = nullptr;
+static volatile uint8_t renderFps = DEFAULT_RENDER_FPS;
+static volatile bool renderEnabled = false;
+// 罗盘状态下正在显示传感器的方位角, 静止时可以降低帧率
+static volatile bool showingSensor = false;
+
+// 上一次渲染使用的数据源和序号, 数据源没有新值且指针已停止时不推进弹簧
+static Event::Source lastSource = Event::Source::OTHER;
+static uint16_t lastSeq = 0;
+// 上一次采样的时间, 弹簧按两帧之间实际经过的时间推进
+static int64_t lastSampleTime = 0;
+// 开启渲染后第一次采样时指针直接放到目标位置
+static bool springStarted = false;
+// 上一次写入LED的画面
+static int lastIndex = -1;
+static uint32_t lastColor = 0;
+static uint8_t lastBrightness = 0;
+// 开启渲染的时间, 校准动画从这里开始计时
+static uint32_t enabledAt = 0;
+// 上一次写入LED的校准动画位置
+static int lastScroll = INT32_MIN;
+
+// Web接口指定的画面, index 为负数时全部LED显示 color. 序号变化表示有新的请求
+struct Override {
+  uint32_t seq;
+  int index;
+  uint32_t color;
+};
+// 请求来自AsyncTCP任务, 绘制在渲染任务中
+static std::mutex overrideMutex;
+static Override pendingOverride = {0, -1, 0};
+// 已经绘制(或丢弃)的请求序号
+static uint32_t drawnOverride = 0;
+
+/**
+ * @brief 采样当前帧的输入, 经弹簧插值后计算帧索引和指针颜色.
+ * 颜色和位置每帧都重新读取, 只有弹簧插值在数据源没有新值且指针已停止时跳过
+ * @return 数据源没有数据, 或结果不合法时返回false
+ */
+static bool sample(Context &context, const ContextSnapshot &snap, int &index,
+                   uint32_t &color) {
+  Event::Source source;
+  WorkType workType = snap.workType;
+  bool gpsFixed = snap.gpsFixed;
+  if (workType == WorkType::SPAWN) {
+    // 当前位置有效时使用SENSOR数据计算目标位置方位角, 否则显示来自Nether的方位角
+    source = gpsFixed ? Event::Source::SENSOR : Event::Source::NETHER;
+    color = snap.color.spawnColor;
+  } else if (workType == WorkType::SOUTH) {
+    // 指南针模式下只读取订阅的源, 否则会受到随机数据影响
+    source = snap.subscribeSource;
+    color = snap.color.southColor;
+  } else {
+    // MOD 模式, 只显示来自服务器的数据, 指针颜色由 /setIndex 设置
+    source = Event::Source::WEB_SERVER;
+    color = 0;
+  }
+
+  angle::Centideg target;
+  uint16_t seq;
+  if (!mailbox::read(source, target, &seq)) {
+    return false;
+  }
+  int64_t now = esp_timer_get_time();
+  int64_t elapsed = now - lastSampleTime;
+  lastSampleTime = now;
+  angle::Centideg azimuth;
+  if (springStarted && source == lastSource && seq == lastSeq &&
+      spring::settled(target)) {
+    azimuth = spring::getAzimuth();
+  } else {
+    lastSource = source;
+    lastSeq = seq;
+    if (!springStarted) {
+      spring::reset(target);
+      springStarted = true;
+    }
+    // 所有数据源使用同一个弹簧, 切换数据源时指针从当前位置转过去
+    uint32_t start = metrics::now();
+    azimuth = spring::update(target, elapsed);
+    metrics::record(metrics::Stage::SPRING, start);
+    if (workType == WorkType::SOUTH) {
+      context.setAzimuth(azimuth);
+    }
+  }
+
+  // 出生点和当前位置可能在方位角不变时更新, 帧索引每帧重新计算
+  if (workType == WorkType::SPAWN && gpsFixed) {
+    index = pixel::indexByLocation(
+        snap.currentLocation.latitude, snap.currentLocation.longitude,
+        snap.spawnLocation.latitude, snap.spawnLocation.longitude, azimuth,
+        lastIndex);
+  } else {
+    index = pixel::indexByAzimuth(azimuth, lastIndex);
+  }
+  return index >= 0;
+}
+
+/**
+ * @brief 校准状态的动画: 先倒计时, 再滚动显示校准文字,
+ * 文字颜色随校准进度由红变绿. 按时间计算位置, 不阻塞渲染任务
+ * @return 本帧是否写入了LED
+ */
+static bool calibrationFrame() {
+  static const char text[] = CALIBRATE_TEXT;
+  const int length = sizeof(text) - 1;
+  uint32_t elapsed = millis() - enabledAt;
+  int scroll;
+  uint32_t color;
+  if (elapsed < CALIBRATE_COUNTDOWN_MS) {
+    // 倒计时用负数表示, 与滚动位置区分
+    scroll = -(int)((CALIBRATE_COUNTDOWN_MS - elapsed + 999) / 1000);
+    color = 0xff0000;
+  } else {
+    // 文字从右侧移入, 完全移出左侧后重新开始
+    int step = (elapsed - CALIBRATE_COUNTDOWN_MS) / CALIBRATE_SCROLL_MS;
+    scroll = step % (10 + length * 4 + 1);
+    uint8_t green = 255 * calibrator::progress();
+    color = ((uint32_t)(255 - green) << 16) | ((uint32_t)green << 8);
+  }
+  if (scroll == lastScroll && color == lastColor) {
+    return false;
+  }
+  lastScroll = scroll;
+  lastColor = color;
+  pixel::clear();
+  if (scroll < 0) {
+    pixel::drawChar('0' - scroll, 4, 0, color);
+  } else {
+    for (int i = 0; i < length; i++) {
+      pixel::drawChar(text[i], 10 - scroll + i * 4, 0, color);
+    }
+  }
+  pixel::show();
+  return true;
+}
+
+/**
+ * @brief 绘制Web接口指定的画面. 不修改 lastIndex 等, 数据源的画面不变时保持显示
+ * @return 没有新的请求时返回false
+ */
+static bool overrideFrame() {
+  Override next;
+  {
+    std::lock_guard<std::mutex> lock(overrideMutex);
+    next = pendingOverride;
+  }
+  if (next.seq == drawnOverride) {
+    return false;
+  }
+  drawnOverride = next.seq;
+  if (next.index < 0) {
+    pixel::showSolid(next.color);
+  } else {
+    pixel::setPointerColor(next.color);
+    pixel::showFrame(next.index);
+  }
+  return true;
+}
+
+static void requestOverride(int index, uint32_t color) {
+  {
+    std::lock_guard<std::mutex> lock(overrideMutex);
+    pendingOverride.seq++;
+    pendingOverride.index = index;
+    pendingOverride.color = color;
+  }
+  render::wake();
+}
+
+void render::showSolid(uint32_t color) { requestOverride(-1, color); }
+
+void render::showFrame(int index, uint32_t color) {
+  if (index < 0 || index > MAX_FRAME_INDEX) {
+    return;
+  }
+  requestOverride(index, color);
+}
+
+bool render::frame() {
+  uint32_t start = metrics::now();
+  Context &context = Context::getInstance();
+  // 每帧只取一次快照, 本帧用到的字段来自同一次发布
+  ContextSnapshot snap = context.snapshot();
+  bool written = false;
+  int index;
+  uint32_t color;
+  if (renderEnabled) {
+    // 亮度由Web/BLE回调写入上下文, LED相关的调用都在渲染任务中
+    pixel::setBrightness(snap.brightness);
+  }
+  if (renderEnabled && snap.deviceState == State::CALIBRATE) {
+    written = calibrationFrame();
+  } else if (renderEnabled && snap.deviceState == State::COMPASS &&
+             overrideFrame()) {
+    written = true;
+  } else if (renderEnabled && snap.deviceState == State::COMPASS &&
+             sample(context, snap, index, color)) {
+    showingSensor = lastSource == Event::Source::SENSOR;
+    uint8_t brightness = snap.brightness;
+    if (index != lastIndex || color != lastColor ||
+        brightness != lastBrightness) {
+      if (snap.workType != WorkType::MOD) {
+        pixel::setPointerColor(color);
+      }
+      pixel::showFrame(index);
+      lastIndex = index;
+      lastColor = color;
+      lastBrightness = brightness;
+      written = true;
+    }
+  }
+  metrics::recordFrame(written, start, F_CPU / renderFps);
+  return written;
+}
+
+static void renderLoop(void *) {
+  TickType_t lastWake = xTaskGetTickCount();
+  for (;;) {
+    TickType_t period = pdMS_TO_TICKS(1000 / render::getFps());
+    period = period > 0 ? period : 1;
+    TickType_t elapsed = xTaskGetTickCount() - lastWake;
+    // 静止时周期较长, 恢复运动时由 wake 通知提前结束等待
+    if (elapsed < period && ulTaskNotifyTake(pdTRUE, period - elapsed) != 0) {
+      lastWake = xTaskGetTickCount();
+    } else {
+      lastWake += period;
+    }
+    render::frame();
+  }
+}
+
+void render::init(Context *context, uint8_t fps) {
+  setFps(fps);
+  spring::setParams(preference::getSpringParams());
+  if (renderTask != nullptr) {
+    return;
+  }
+  ESP_LOGI(TAG, "Render init %p, fps=%d", context, renderFps);
+  xTaskCreate(renderLoop, "render", 4096, nullptr, configMAX_PRIORITIES - 2,
+              &renderTask);
+}
+
+void render::setFps(uint8_t fps) { renderFps = fps > 0 ? fps : 1; }
+
+uint8_t render::getFps() {
+  if (showingSensor && renderEnabled && motion::isStationary()) {
+    uint8_t idleHz = motion::getPolicy().idleHz;
+    return idleHz < renderFps ? idleHz : renderFps;
+  }
+  return renderFps;
+}
+
+void render::wake() {
+  if (renderTask != nullptr) {
+    xTaskNotifyGive(renderTask);
+  }
+}
+
+void render::setEnabled(bool enabled) {
+  if (enabled && !renderEnabled) {
+    // 其他状态可能改写过LED, 重新进入时强制重绘
+    lastIndex = -1;
+    lastSeq = 0;
+    lastScroll = INT32_MIN;
+    showingSensor = false;
+    springStarted = false;
+    // 关闭期间的时间不计入弹簧的第一步
+    lastSampleTime = esp_timer_get_time();
+    enabledAt = millis();
+    std::lock_guard<std::mutex> lock(overrideMutex);
+    drawnOverride = pendingOverride.seq;
+  }
+  renderEnabled = enabled;
+}
@@ -1,92 +1,239 @@
 #include "board.h"
 #include <Arduino.h>
+#include <atomic>
 #include <math.h>
+#include <mutex>
+#include <new>
+#include <type_traits>
 
 #include "context.h"
 
-#include "MMC5883MAAdapter.h"
-#include "MagneticSensor.h"
-#include "QMC5883LAdapter.h"
-#include "QMC5883PAdapter.h"
+#include "AsyncI2CTransport.h"
+#include "Magnetometer.h"
 
 using namespace mcompass;
 static const char *TAG = "SENSOR";
 
+// 探测到的驱动构造在静态存储中, 不在堆上分配; 三种型号只有 Traits 不同, 大小相同
+static std::aligned_storage<sizeof(QMC5883LDriver),
+                            alignof(QMC5883LDriver)>::type driverStorage;
+// 与型号无关的操作(校准参数, 滤波)直接调用
 static MagneticSensor *magneticSensor;
+// 与型号有关的两步各经过一次函数指针, 指向探测到的型号的实例化
+static bool (*requestSample)(MagneticSensor::SampleCallback callback,
+                             void *arg) = nullptr;
+static angle::Centideg (*filteredAzimuth)() = nullptr;
+static bool (*setIdle)(bool idle) = nullptr;
 static SensorModel sm = SensorModel::UNKNOWN;
 
-void sensor::init(Context *context) {
-  int retry = 3;
-  // 初始化i2cm esp32-c3-devkitm-1默认I2C引脚8和9,这里需要手动修改回4和5
-  Wire.begin(4, 5);
-  // 0x0D QMC5883L
-  // 0x2C QMC5883P
-  // 0x30 MMC5883MA
-  // 遍历已知的地磁传感器地址,判断当前地磁传感器型号
-  for (int i = 0; i < retry; i++) {
-    Wire.beginTransmission(0x0D);
-    if (Wire.endTransmission() == 0) {
-      ESP_LOGI(TAG, "Found QMC5883L at address 0x0D");
-      sm = SensorModel::QMC5883L;
-      magneticSensor = new QMC5883LAdapter();
-      break;
+// 采样任务与 setTransport 都会访问传感器, 串行执行
+static std::mutex sensorMutex;
+static TaskHandle_t sampleTask = nullptr;
+// 异步I2C传输层, 未通过 setTransport 指定时使用 ESP-IDF I2C 驱动
+static I2CTransport *transport = nullptr;
+
+// 单生产者(I2C传输完成回调)单消费者(传感器定时器)环形缓冲
+static sensor::RawSample ring[SENSOR_RING_SIZE];
+static std::atomic<uint32_t> ringHead{0}; // 下一个写入位置, 只由生产者修改
+static std::atomic<uint32_t> ringTail{0}; // 下一个读取位置, 只由消费者修改
+static sensor::SampleStats sampleStats = {};
+// 没有新采样时沿用上一次的方位角
+static angle::Centideg lastAzimuth = 0;
+// 上一个送入滤波器的采样时间
+static int64_t lastSampleTime = 0;
+// 采样任务的查询周期, 静止时降低
+static volatile uint32_t pollMs = SENSOR_POLL_MS;
+// 采样任务已经应用的静止/运动设置: 查询和定时器周期, 传感器输出数据率.
+// 只在采样任务中访问, 见 applyMotion
+static bool ratesIdle = false;
+static bool odrIdle = false;
+
+static_assert((SENSOR_RING_SIZE & (SENSOR_RING_SIZE - 1)) == 0,
+              "SENSOR_RING_SIZE must be a power of two");
+
+template <typename Driver> static Driver &driver() {
+  return *reinterpret_cast<Driver *>(&driverStorage);
+}
+
+template <typename Driver>
+static bool requestSampleWith(MagneticSensor::SampleCallback callback,
+                              void *arg) {
+  return driver<Driver>().requestSample(callback, arg);
+}
+
+template <typename Driver> static angle::Centideg filteredAzimuthWith() {
+  return driver<Driver>().getFilteredAzimuthCentideg();
+}
+
+template <typename Driver> static bool setIdleWith(bool idle) {
+  return driver<Driver>().setIdle(idle);
+}
+
+/**
+ * @brief 在静态存储中构造驱动并写入配置寄存器, 只在探测到型号后调用一次
+ */
+template <typename Driver> static void createDriver() {
+  static_assert(sizeof(Driver) <= sizeof(driverStorage),
+                "driverStorage too small");
+  Driver *instance = new (&driverStorage) Driver();
+  instance->init();
+  magneticSensor = instance;
+  requestSample = requestSampleWith<Driver>;
+  filteredAzimuth = filteredAzimuthWith<Driver>;
+  setIdle = setIdleWith<Driver>;
+}
+
+static void createDriver(SensorModel model) {
+  switch (model) {
+  case SensorModel::QMC5883L:
+    createDriver<QMC5883LDriver>();
+    break;
+  case SensorModel::QMC5883P:
+    createDriver<QMC5883PDriver>();
+    break;
+  case SensorModel::MMC5883MA:
+    createDriver<MMC5883MADriver>();
+    break;
+  default:
+    break;
+  }
+}
+
+static void sampleLoop(void *) {
+  TickType_t lastWake = xTaskGetTickCount();
+  bool running = false;
+  for (;;) {
+    TickType_t period = pdMS_TO_TICKS(pollMs);
+    TickType_t elapsed = xTaskGetTickCount() - lastWake;
+    // 静止时周期较长, 恢复运动时由 onMotion 通知提前结束等待
+    if (elapsed < period && ulTaskNotifyTake(pdTRUE, period - elapsed) != 0) {
+      lastWake = xTaskGetTickCount();
+    } else {
+      lastWake += period;
     }
-    delay(100);
-    Wire.beginTransmission(0x2C);
-    if (Wire.endTransmission() == 0) {
-      ESP_LOGI(TAG, "Found QMC5883P at address 0x2C");
-      sm = SensorModel::QMC5883P;
-      magneticSensor = new QMC5883PAdapter();
-      break;
+    // 数据源管理停止传感器时(非指南针状态, 或不需要传感器)不再访问I2C
+    bool wasRunning = running;
+    running = source::isRunning(Event::Source::SENSOR);
+    if (running && !wasRunning) {
+      // 停止前的采样窗口已经过时, 恢复时回到运动状态, 由 sample 恢复全速采样
+      motion::reset();
     }
-    delay(100);
-    Wire.beginTransmission(0x30);
-    if (Wire.endTransmission() == 0) {
-      ESP_LOGI(TAG, "Found MMC5883MA at address 0x30");
-      sm = SensorModel::MMC5883MA;
-      magneticSensor = new MMC5883MAAdapter();
-      break;
+    if (running) {
+      sensor::sample();
     }
   }
-  // 进行一次全量I2C扫描
-  if (sm == SensorModel::UNKNOWN) {
-    Serial.println(
-        "Unknown magnetometer found. Performing full I2C bus scan...");
-    byte error, address;
-    int nDevices = 0;
-    for (address = 1; address < 127; address++) { // I2C地址范围通常是0x01到0x7F
-      Wire.beginTransmission(address);
-      error = Wire.endTransmission();
-      if (error == 0) {
-        Serial.print("  I2C device found at address 0x");
-        if (address < 16)
-          Serial.print("0");
-        Serial.print(address, HEX);
-        Serial.println("!");
-        if (address == 0x0D) {
-          sm = SensorModel::QMC5883L;
-        } else if (address == 0x2C) {
-          sm = SensorModel::QMC5883P;
-        } else if (address == 0x30) {
-          sm = SensorModel::MMC5883MA;
+}
+
+// 已知的地磁传感器, 探测时按顺序确认
+struct Candidate {
+  SensorModel model;
+  uint8_t address;
+  bool (*identify)();
+};
+static const Candidate candidates[] = {
+    {SensorModel::QMC5883L, QMC5883LTraits::kAddress,
+     QMC5883LDriver::identify},
+    {SensorModel::QMC5883P, QMC5883PTraits::kAddress,
+     QMC5883PDriver::identify},
+    {SensorModel::MMC5883MA, MMC5883MATraits::kAddress,
+     MMC5883MADriver::identify},
+};
+
+// 按地址查找型号, 不是已知的地址时返回 nullptr
+static const Candidate *candidateAt(uint8_t address) {
+  for (const Candidate &candidate : candidates) {
+    if (candidate.address == address) {
+      return &candidate;
+    }
+  }
+  return nullptr;
+}
+
+// 地址上有设备应答
+static bool acknowledges(uint8_t address) {
+  Wire.beginTransmission(address);
+  return Wire.endTransmission() == 0;
+}
+
+/**
+ * @brief 探测传感器型号.
+ * 先按NVS中保存的型号读一次芯片ID确认, 不一致时按已知地址是否应答探测, 每轮之间不等待;
+ * 仍未找到时扫描总线, 应答的已知地址按地址确定型号.
+ * 芯片ID只用于确认缓存, 兼容芯片的ID可能不同, 不能据此排除
+ */
+static SensorModel probe() {
+  uint16_t timeOut = Wire.getTimeOut();
+  // 不存在的地址只等待很短的时间
+  Wire.setTimeOut(SENSOR_PROBE_TIMEOUT_MS);
+  preference::SensorInfo cached = preference::getSensorInfo();
+  const Candidate *found = candidateAt(cached.address);
+  if (found != nullptr && found->model == cached.model && found->identify()) {
+    ESP_LOGI(TAG, "Verified cached %s at address 0x%02X",
+             utils::sensorModel2Str(found->model).c_str(), found->address);
+  } else {
+    found = nullptr;
+  }
+  for (int i = 0; found == nullptr && i < SENSOR_PROBE_RETRY; i++) {
+    for (const Candidate &candidate : candidates) {
+      if (acknowledges(candidate.address)) {
+        ESP_LOGI(TAG, "Found %s at address 0x%02X",
+                 utils::sensorModel2Str(candidate.model).c_str(),
+                 candidate.address);
+        found = &candidate;
+        break;
+      }
+    }
+  }
+  if (found == nullptr) {
+    ESP_LOGW(TAG, "Unknown magnetometer, scanning I2C bus");
+    for (uint8_t address = 1; address < 127; address++) {
+      if (acknowledges(address)) {
+        ESP_LOGW(TAG, "I2C device found at address 0x%02X", address);
+        if (found == nullptr) {
+          found = candidateAt(address);
         }
       }
     }
-    if (sm == SensorModel::UNKNOWN) {
-      ESP_LOGE(TAG, "Sensor init failed");
-      context->setHasSensor(false);
-      context->setDeviceState(State::INFO);
-      Event::Body event;
-      event.type = Event::Type::TEXT;
-      event.source = Event::Source::SENSOR;
-      memcpy(event.TEXT.text, SENSOR_ERROR, sizeof(SENSOR_ERROR));
-      ESP_ERROR_CHECK(esp_event_post_to(context->getEventLoop(), MCOMPASS_EVENT,
-                                        0, &event, sizeof(event), 0));
-      return;
+  }
+  Wire.setTimeOut(timeOut);
+  if (found == nullptr) {
+    return SensorModel::UNKNOWN;
+  }
+  if (found->model != cached.model || found->address != cached.address) {
+    preference::setSensorInfo({found->model, found->address});
+  }
+  return found->model;
+}
+
+void sensor::init(Context *context) {
+  // 初始化i2cm esp32-c3-devkitm-1默认I2C引脚8和9,这里需要手动修改回4和5
+  Wire.begin(4, 5);
+  sm = probe();
+  metrics::bootMark(metrics::BootMark::SENSOR_PROBED);
+  if (sm == SensorModel::UNKNOWN) {
+    ESP_LOGE(TAG, "Sensor init failed");
+    context->setHasSensor(false);
+    context->setDeviceState(State::INFO);
+    Event::Body event;
+    event.type = Event::Type::TEXT;
+    event.source = Event::Source::SENSOR;
+    memcpy(event.TEXT.text, SENSOR_ERROR, sizeof(SENSOR_ERROR));
+    context->postEvent(event);
+    return;
+  }
+  createDriver(sm);
+  if (transport == nullptr) {
+    AsyncI2CTransport *async = new AsyncI2CTransport();
+    if (async->begin(configMAX_PRIORITIES - 3)) {
+      transport = async;
+    } else {
+      ESP_LOGE(TAG, "I2C transport init failed, fall back to Wire");
+      delete async;
     }
   }
-  magneticSensor->init();
+  magneticSensor->setTransport(transport);
   context->setSensorModel(sm);
+  trace::recordSensorModel(sm);
 
   // 还原传感器的校准数据
   preference::CalibrationData data = preference::getCalibration();
@@ -100,60 +247,169 @@ void sensor::init(Context *context) {
                                           data.offsets[2]);
     magneticSensor->setCalibrationScales(data.scales[0], data.scales[1],
                                          data.scales[2]);
+    if (data.matrix[0][0] != 0 || data.matrix[1][1] != 0 ||
+        data.matrix[2][2] != 0) {
+      ESP_LOGW(TAG, "restore soft iron matrix, quality=%.2f", data.quality);
+      magneticSensor->setSoftIronMatrix(data.matrix);
+    }
+  }
+  calibrator::init(data.quality);
+  motion::setPolicy(preference::getMotionPolicy());
+  if (sampleTask == nullptr) {
+    // 优先级低于渲染任务, 高于数据事件循环
+    xTaskCreate(sampleLoop, "sensor", 4096, nullptr, configMAX_PRIORITIES - 3,
+                &sampleTask);
   }
+  metrics::bootMark(metrics::BootMark::SENSOR_READY);
 }
 
-void sensor::calibrate() {
-  if (nullptr == magneticSensor) {
+/**
+ * @brief 按运动检测的当前状态调整采样任务和传感器定时器的周期, 以及传感器输出数据率.
+ * 在采样任务中每次提交采样前调用, 不在I2C传输层的回调里修改定时器或排队写寄存器.
+ * 输出数据率的写入没有排上队时保留原设置, 下一次采样前重试
+ */
+static void applyMotion() {
+  bool stationary = motion::isStationary();
+  if (stationary != ratesIdle) {
+    ratesIdle = stationary;
+    uint8_t idleHz = motion::getPolicy().idleHz;
+    ESP_LOGI(TAG, "%s, %u Hz", stationary ? "stationary" : "moving",
+             stationary ? idleHz : 1000 / SENSOR_POLL_MS);
+    pollMs = stationary ? 1000 / idleHz : SENSOR_POLL_MS;
+    source::setPeriod(Event::Source::SENSOR,
+                      stationary ? 1000000 / idleHz : SENSOR_TICK_US);
+    if (!stationary) {
+      render::wake();
+    }
+  }
+  if (stationary != odrIdle) {
+    if (setIdle(stationary)) {
+      odrIdle = stationary;
+    } else {
+      sampleStats.odrRetries++;
+      ESP_LOGW(TAG, "ODR write not queued, retry");
+    }
+  }
+}
+
+/**
+ * @brief 一次采样请求完成, 在I2C传输层的任务中执行.
+ * 读数只在回调期间有效, 在这里复制进环形缓冲, 其他任务不直接访问驱动的读数
+ * @param arg 请求提交时的周期计数, 统计请求到数据返回的延迟
+ * @param xyz 未校准读数, 数据未就绪时为 nullptr
+ */
+static void onSample(void *arg, const int16_t *xyz) {
+  metrics::record(metrics::Stage::I2C_READ, (uint32_t)(uintptr_t)arg);
+  if (xyz == nullptr) {
+    sampleStats.notReady++;
+    return;
+  }
+  sensor::RawSample sample = {esp_timer_get_time(), {xyz[0], xyz[1], xyz[2]}};
+  trace::recordMagnetometer(sample.xyz[0], sample.xyz[1], sample.xyz[2]);
+  if (motion::feed(sample.xyz, sample.timestamp) && sampleTask != nullptr) {
+    // 由采样任务调整周期和数据率; 恢复运动时也立即结束静止时较长的等待
+    xTaskNotifyGive(sampleTask);
+  }
+
+  uint32_t head = ringHead.load(std::memory_order_relaxed);
+  if (head - ringTail.load(std::memory_order_acquire) >= SENSOR_RING_SIZE) {
+    // 消费者跟不上, 丢弃最新的采样
+    sampleStats.overruns++;
     return;
   }
-  magneticSensor->calibrate();
-  ESP_LOGW(TAG, "setCalibrationOffsets(%f, %f,%f)",
-           magneticSensor->getCalibrationOffset(0),
-           magneticSensor->getCalibrationOffset(1),
-           magneticSensor->getCalibrationOffset(2));
-  ESP_LOGW(TAG, "setCalibrationScales(%f, %f,%f)",
-           magneticSensor->getCalibrationScale(0),
-           magneticSensor->getCalibrationScale(1),
-           magneticSensor->getCalibrationScale(2));
-  preference::CalibrationData data;
-  data.offsets[0] = magneticSensor->getCalibrationOffset(0);
-  data.offsets[1] = magneticSensor->getCalibrationOffset(1);
-  data.offsets[2] = magneticSensor->getCalibrationOffset(2);
-  data.scales[0] = magneticSensor->getCalibrationScale(0);
-  data.scales[1] = magneticSensor->getCalibrationScale(1);
-  data.scales[2] = magneticSensor->getCalibrationScale(2);
-  preference::setCalibration(data);
-  ESP_LOGW(TAG, "Calibration data saved to preferences");
+  ring[head & (SENSOR_RING_SIZE - 1)] = sample;
+  ringHead.store(head + 1, std::memory_order_release);
+  sampleStats.samples++;
 }
 
+bool sensor::sample() {
+  if (nullptr == magneticSensor) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(sensorMutex);
+  applyMotion();
+  // 上一次请求还在传输时不重复提交
+  return requestSample(onSample, (void *)(uintptr_t)metrics::now());
+}
+
+void sensor::setTransport(I2CTransport *i2c) {
+  transport = i2c;
+  if (magneticSensor) {
+    magneticSensor->setTransport(i2c);
+  }
+}
+
+bool sensor::pop(sensor::RawSample &out) {
+  uint32_t tail = ringTail.load(std::memory_order_relaxed);
+  if (tail == ringHead.load(std::memory_order_acquire)) {
+    return false;
+  }
+  out = ring[tail & (SENSOR_RING_SIZE - 1)];
+  ringTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+sensor::SampleStats sensor::stats() { return sampleStats; }
+
+uint32_t sensor::getPollMs() { return pollMs; }
+
 /**
  * @brief 获取当前方位角
  */
 
-int sensor::getAzimuth() {
+angle::Centideg sensor::getAzimuth() {
   if (nullptr == magneticSensor) {
     return 0;
   }
-  magneticSensor->read();
-  int azimuth = magneticSensor->getAzimuth();
-
-  switch (sm) {
-  case SensorModel::QMC5883P: {
-    // QMC5883P的方位角需要特殊处理,他的Y轴和QMC5883L的Y轴是反向的
-    // 需要将Y轴的值取反, 并且坐标相对于QMC5883L需要旋转90度
-    azimuth += 90;
-    if (azimuth >= 360) {
-      azimuth -= 360;
+  uint32_t start = metrics::now();
+  sensor::RawSample sample;
+  int count = 0;
+  // 后台求解的椭球校准在这里应用, 与方位角计算在同一个任务中
+  calibrator::Result calibration;
+  if (calibrator::take(calibration)) {
+    magneticSensor->setCalibrationOffsets(calibration.offsets[0],
+                                          calibration.offsets[1],
+                                          calibration.offsets[2]);
+    magneticSensor->setSoftIronMatrix(calibration.matrix);
+    Context &context = Context::getInstance();
+    if (context.getDeviceState() == State::CALIBRATE) {
+      // 校准状态下第一个合格的结果即结束校准, 新数据已经生效, 不需要重启
+      Event::Body event;
+      event.type = Event::Type::CALIBRATION_DONE;
+      event.source = Event::Source::SENSOR;
+      context.postEvent(event);
     }
-    break;
   }
-  case SensorModel::QMC5883L: {
-    azimuth = 360 - azimuth; // 将方位角转换为0-360度范围
+  // 每个采样都送入抽取滤波器, 按定时器的速率输出; 同时送入在线校准
+  // 静止时的查询周期可能超过 SENSOR_FILTER_RESET_US, 间隔按当前周期放宽
+  int64_t resetGap = (int64_t)pollMs * 2000;
+  if (resetGap < SENSOR_FILTER_RESET_US) {
+    resetGap = SENSOR_FILTER_RESET_US;
   }
-  default:
-    break;
+  while (sensor::pop(sample)) {
+    if (sample.timestamp - lastSampleTime > resetGap) {
+      // 采样中断过(数据源被停止), 不再使用之前的滤波状态
+      magneticSensor->resetFilter();
+    }
+    lastSampleTime = sample.timestamp;
+    magneticSensor->pushSample(sample.xyz[0], sample.xyz[1], sample.xyz[2]);
+    calibrator::feed(sample.xyz);
+    count++;
+  }
+  if (count == 0) {
+    return lastAzimuth;
   }
+  // 型号的轴向换算在驱动的实例化中完成
+  angle::Centideg azimuth = filteredAzimuth();
+  metrics::record(metrics::Stage::HEADING_MATH, start);
+  lastAzimuth = azimuth;
+  return azimuth;
+}
+
+angle::Centideg sensor::tick() {
+  angle::Centideg azimuth = sensor::getAzimuth();
+  // 弹簧插值在渲染任务中按帧间隔进行, 这里发布目标方位角
+  mailbox::publish(Event::Source::SENSOR, azimuth);
   return azimuth;
 }
 
@@ -0,0 +1,111 @@
+#include <Arduino.h>
+#include <esp_log.h>
+#include <mutex>
+
+#include "board.h"
+#include "context.h"
+
+using namespace mcompass;
+
+static const char *TAG = "SOURCE";
+
+#define SOURCE_COUNT (Event::Source::NETHER + 1)
+
+struct Producer {
+  esp_timer_handle_t timer;
+  uint64_t periodUs;
+};
+
+static Producer producers[SOURCE_COUNT];
+// update 会在多个任务中被调用(事件循环, AsyncTCP, NMEA解析), 串行执行
+static std::mutex updateMutex;
+
+/**
+ * @brief 当前上下文下需要运行的数据源
+ */
+static uint32_t demandMask(const ContextSnapshot &snap) {
+  if (snap.deviceState == State::CALIBRATE) {
+    // 校准状态下只需要传感器采样, 进度由在线校准的覆盖度决定
+    return 1u << Event::Source::SENSOR;
+  }
+  if (snap.deviceState != State::COMPASS) {
+    return 0;
+  }
+  switch (snap.workType) {
+  case WorkType::SPAWN:
+    // 与渲染任务一致: 定位有效时用传感器, 否则显示Nether
+    return 1u << (snap.gpsFixed ? Event::Source::SENSOR
+                                : Event::Source::NETHER);
+  case WorkType::SOUTH: {
+    Event::Source source = snap.subscribeSource;
+    if (source == Event::Source::SENSOR || source == Event::Source::NETHER) {
+      return 1u << source;
+    }
+    return 0;
+  }
+  default:
+    // MOD 模式只显示服务器推送的数据
+    return 0;
+  }
+}
+
+static bool validSource(Event::Source source) {
+  return static_cast<size_t>(source) < SOURCE_COUNT;
+}
+
+void source::attach(Event::Source source, esp_timer_handle_t timer,
+                    uint64_t periodUs) {
+  if (!validSource(source)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(updateMutex);
+    producers[source] = {timer, periodUs};
+  }
+  update();
+}
+
+void source::setPeriod(Event::Source source, uint64_t periodUs) {
+  if (!validSource(source) || periodUs == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(updateMutex);
+  Producer &producer = producers[source];
+  if (producer.periodUs == periodUs) {
+    return;
+  }
+  producer.periodUs = periodUs;
+  if (producer.timer != nullptr && esp_timer_is_active(producer.timer)) {
+    esp_timer_stop(producer.timer);
+    esp_timer_start_periodic(producer.timer, periodUs);
+  }
+}
+
+uint64_t source::getPeriod(Event::Source source) {
+  return validSource(source) ? producers[source].periodUs : 0;
+}
+
+bool source::isRunning(Event::Source source) {
+  return validSource(source) && producers[source].timer != nullptr &&
+         esp_timer_is_active(producers[source].timer);
+}
+
+void source::update() {
+  std::lock_guard<std::mutex> lock(updateMutex);
+  uint32_t demand = demandMask(Context::getInstance().snapshot());
+  for (size_t i = 0; i < SOURCE_COUNT; i++) {
+    Producer &producer = producers[i];
+    if (producer.timer == nullptr) {
+      continue;
+    }
+    bool wanted = demand & (1u << i);
+    bool active = esp_timer_is_active(producer.timer);
+    if (wanted && !active) {
+      esp_timer_start_periodic(producer.timer, producer.periodUs);
+      ESP_LOGI(TAG, "start %s", Event::SourceToString((Event::Source)i));
+    } else if (!wanted && active) {
+      esp_timer_stop(producer.timer);
+      ESP_LOGI(TAG, "stop %s", Event::SourceToString((Event::Source)i));
+    }
+  }
+}
@@ -0,0 +1,172 @@
+#include <math.h>
+#include <mutex>
+
+#include "board.h"
+
+using namespace mcompass;
+
+// 内部单位: 1/256 个0.01度, 用整数运算保留足够的精度
+#define SPRING_FRAC_BITS 8
+// 状态转移系数的小数位数
+#define SPRING_COEFF_BITS 20
+static const int32_t kTurn = angle::FULL_TURN << SPRING_FRAC_BITS;
+
+// 模拟指针的当前状态. 不足1毫秒的时间留到下一次, 步长按毫秒取整后不会累积误差
+static spring::State g_state;
+
+// 单步最长的时间, 更长的停顿(比如渲染被挂起)按这个时间推进, 此时指针早已停止
+static const uint32_t max_step_ms = 10000;
+// 速度上限(一秒五圈), 保证状态转移的结果不会溢出 int32
+static const int32_t max_velocity = 5 * kTurn;
+// 角度差小于半个0.01度, 速度小于每秒一个0.01度时认为停止
+static const int32_t settle_distance = 1 << (SPRING_FRAC_BITS - 1);
+static const int32_t settle_velocity = 1 << SPRING_FRAC_BITS;
+
+// setParams 来自Web回调, update 在渲染任务中
+static std::mutex paramsMutex;
+static spring::Params params = spring::defaultParams();
+// 参数每次修改加一, 缓存的系数随之失效
+static uint32_t generation = 1;
+
+/// 时间步长 dt 的状态转移矩阵 [x, v] <- [[a, b], [c, d]] * [x, v]
+struct Transition {
+  uint32_t dtMs;
+  uint32_t generation;
+  int32_t a, b, c, d; // SPRING_COEFF_BITS 位小数
+};
+// 按步长直接映射的缓存, 帧周期只有一两种取值, 平时不需要浮点运算
+static Transition cache[4];
+
+/**
+ * @brief 计算 exp(A dt), A = [[0, 1], [-k, -c]].
+ * 特征根 -α ± γ, α = c / 2, γ = √(α² - k); 形式统一为
+ * [[ec + α es, es], [-k es, ec - α es]], ec = e^(-αt) co, es = e^(-αt) s.
+ * 欠阻尼和临界阻尼用 sin/cos 和线性项; 过阻尼直接用两个衰减的指数
+ * e^(-(α-γ)t), e^(-(α+γ)t) 表示, 不单独计算会溢出的 cosh/sinh
+ */
+static void computeTransition(const spring::Params &p, uint32_t dtMs,
+                              Transition &out) {
+  float t = dtMs / 1000.0f;
+  float alpha = p.damping / 2;
+  float disc = alpha * alpha - p.stiffness;
+  float ec, es;
+  if (disc < -1e-6f) {
+    float beta = sqrtf(-disc);
+    float e = expf(-alpha * t);
+    ec = e * cosf(beta * t);
+    es = e * sinf(beta * t) / beta;
+  } else if (disc > 1e-6f) {
+    float gamma = sqrtf(disc);
+    float slow = expf(-(alpha - gamma) * t);
+    float fast = expf(-(alpha + gamma) * t);
+    ec = (slow + fast) / 2;
+    es = (slow - fast) / (2 * gamma);
+  } else {
+    float e = expf(-alpha * t);
+    ec = e;
+    es = e * t;
+  }
+  out.dtMs = dtMs;
+  out.a = fixed::fromFloat(ec + alpha * es, SPRING_COEFF_BITS);
+  out.b = fixed::fromFloat(es, SPRING_COEFF_BITS);
+  out.c = fixed::fromFloat(-p.stiffness * es, SPRING_COEFF_BITS);
+  out.d = fixed::fromFloat(ec - alpha * es, SPRING_COEFF_BITS);
+}
+
+static const Transition &transition(uint32_t dtMs) {
+  std::lock_guard<std::mutex> lock(paramsMutex);
+  Transition &entry = cache[dtMs & 3];
+  if (entry.dtMs != dtMs || entry.generation != generation) {
+    computeTransition(params, dtMs, entry);
+    entry.generation = generation;
+  }
+  return entry;
+}
+
+spring::Params spring::defaultParams() {
+  return {SPRING_STIFFNESS, SPRING_DAMPING};
+}
+
+void spring::setParams(const Params &next) {
+  // 超出范围时系数可能溢出定点数; 没有阻尼时指针永远不会停止
+  if (!(next.stiffness >= SPRING_STIFFNESS_MIN &&
+        next.stiffness <= SPRING_STIFFNESS_MAX) ||
+      !(next.damping > 0 && next.damping <= SPRING_DAMPING_MAX)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(paramsMutex);
+  params = next;
+  generation++;
+}
+
+spring::Params spring::getParams() {
+  std::lock_guard<std::mutex> lock(paramsMutex);
+  return params;
+}
+
+/// 状态中的位置换算为0.01度
+static angle::Centideg azimuthOf(const spring::State &state) {
+  return angle::normalize((state.azimuth + (1 << (SPRING_FRAC_BITS - 1))) >>
+                          SPRING_FRAC_BITS);
+}
+
+angle::Centideg spring::update(angle::Centideg target, int64_t elapsedUs) {
+  return update(g_state, target, elapsedUs);
+}
+
+angle::Centideg spring::update(State &state, angle::Centideg target,
+                               int64_t elapsedUs) {
+  int64_t total = state.residualUs + (elapsedUs > 0 ? elapsedUs : 0);
+  uint32_t dtMs;
+  if (total >= (int64_t)max_step_ms * 1000) {
+    dtMs = max_step_ms;
+    state.residualUs = 0;
+  } else {
+    dtMs = (uint32_t)(total / 1000);
+    state.residualUs = total - (int64_t)dtMs * 1000;
+  }
+  if (dtMs == 0) {
+    return azimuthOf(state);
+  }
+  // 指针相对目标的最短角度差, 比如 -10 度或 +20 度
+  int32_t difference = state.azimuth - (target << SPRING_FRAC_BITS);
+  if (difference > kTurn / 2) {
+    difference -= kTurn;
+  } else if (difference < -kTurn / 2) {
+    difference += kTurn;
+  }
+
+  const Transition &m = transition(dtMs);
+  // 四舍五入, 直接截断的偏差在步长很小时会让指针停不下来
+  const int64_t half = (int64_t)1 << (SPRING_COEFF_BITS - 1);
+  int64_t x = (int64_t)m.a * difference + (int64_t)m.b * state.velocity + half;
+  int64_t v = (int64_t)m.c * difference + (int64_t)m.d * state.velocity + half;
+  difference = (int32_t)(x >> SPRING_COEFF_BITS);
+  state.velocity = (int32_t)max((int64_t)-max_velocity,
+                                min((int64_t)max_velocity,
+                                    v >> SPRING_COEFF_BITS));
+  if (abs(difference) < settle_distance &&
+      abs(state.velocity) < settle_velocity) {
+    difference = 0;
+    state.velocity = 0;
+  }
+  state.azimuth = fixed::wrap((target << SPRING_FRAC_BITS) + difference, kTurn);
+  return azimuthOf(state);
+}
+
+bool spring::settled(angle::Centideg target) {
+  return g_state.velocity == 0 &&
+         g_state.azimuth == (target << SPRING_FRAC_BITS);
+}
+
+void spring::reset(angle::Centideg azimuth) {
+  g_state.azimuth = angle::normalize(azimuth) << SPRING_FRAC_BITS;
+  g_state.velocity = 0;
+  g_state.residualUs = 0;
+}
+
+angle::Centideg spring::getAzimuth() { return azimuthOf(g_state); }
+
+float spring::getVelocity() {
+  return angle::toDegrees(g_state.velocity >> SPRING_FRAC_BITS);
+}
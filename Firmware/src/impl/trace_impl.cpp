@@ -0,0 +1,43 @@
+#include <Arduino.h>
+
+#include "board.h"
+
+using namespace mcompass;
+
+#if defined(ENABLE_TRACE)
+static bool traceEnabled = true;
+#else
+static bool traceEnabled = false;
+#endif
+
+void trace::setEnabled(bool enabled) { traceEnabled = enabled; }
+
+bool trace::isEnabled() { return traceEnabled; }
+
+void trace::recordSensorModel(SensorModel model) {
+  if (!traceEnabled) {
+    return;
+  }
+  Serial.printf("#S %lld %s\n", (long long)esp_timer_get_time(),
+                utils::sensorModel2Str(model).c_str());
+}
+
+void trace::recordMagnetometer(int x, int y, int z) {
+  if (!traceEnabled) {
+    return;
+  }
+  Serial.printf("#M %lld %d %d %d\n", (long long)esp_timer_get_time(), x, y,
+                z);
+}
+
+void trace::recordNmea(const char *line, size_t len) {
+  if (!traceEnabled) {
+    return;
+  }
+  while (len > 0 && (line[len - 1] == '\r' || line[len - 1] == '\n' ||
+                     line[len - 1] == '\0')) {
+    len--;
+  }
+  Serial.printf("#N %lld %.*s\n", (long long)esp_timer_get_time(), (int)len,
+                line);
+}
@@ -76,6 +76,54 @@ static void apis(void) {
     request->send(200, "text/json", json);
   });
 
+  // 运行统计
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    char json[METRICS_JSON_SIZE];
+    if (!metrics::toJson(json, sizeof(json))) {
+      request->send(500);
+      return;
+    }
+    request->send(200, "text/json", json);
+  });
+
+  // 事件队列统计
+  server.on("/eventMetrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    char json[METRICS_JSON_SIZE];
+    if (!metrics::eventsToJson(json, sizeof(json))) {
+      request->send(500);
+      return;
+    }
+    request->send(200, "text/json", json);
+  });
+
+  // 启动耗时
+  server.on("/bootMetrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    char json[METRICS_JSON_SIZE];
+    if (!metrics::bootToJson(json, sizeof(json))) {
+      request->send(500);
+      return;
+    }
+    request->send(200, "text/json", json);
+  });
+
+  // 在设备上比较定点化前后的方位角与弹簧运算周期数
+  server.on("/mathBench", HTTP_GET, [](AsyncWebServerRequest *request) {
+    int iterations = MATH_BENCH_ITERATIONS;
+    if (request->hasParam("iterations")) {
+      iterations = request->getParam("iterations")->value().toInt();
+    }
+    if (iterations <= 0 || iterations > MATH_BENCH_MAX_ITERATIONS) {
+      request->send(400, "text/plain", "Invalid iterations");
+      return;
+    }
+    char json[128];
+    if (!mathbench::toJson(json, sizeof(json), iterations)) {
+      request->send(500);
+      return;
+    }
+    request->send(200, "text/json", json);
+  });
+
   // 获取目标出生点
   server.on("/spawn", HTTP_GET, [](AsyncWebServerRequest *request) {
     clientConnected = true;
@@ -181,8 +229,8 @@ static void apis(void) {
         // 更新设备状态和亮度
         ctx->setBrightness(brightness);
         preference::setBrightness(brightness);
+        // 渲染任务在下一帧应用
         ESP_LOGI(TAG, "set brightness to %d", brightness);
-        pixel::setBrightness(brightness);
         // 返回成功响应
         request->send(200);
       } else {
@@ -203,14 +251,8 @@ static void apis(void) {
       float azimuth = request->getParam("azimuth")->value().toFloat();
       ctx->setSubscribeSource(Event::Source::WEB_SERVER);
       ctx->setWorkType(WorkType::MOD);
-      auto eventLoop = ctx->getEventLoop();
-      Event::Body event;
-      event.type = Event::Type::AZIMUTH;
-      event.source = Event::Source::WEB_SERVER;
-      event.azimuth.angle = azimuth;
-      ESP_LOGI(TAG, "esp_event_post_to %p", eventLoop);
-      ESP_ERROR_CHECK(esp_event_post_to(eventLoop, MCOMPASS_EVENT, 0, &event,
-                                        sizeof(event), 0));
+      mailbox::publish(Event::Source::WEB_SERVER,
+                       angle::fromDegrees(azimuth));
       return request->send(200);
     }
     request->send(400);
@@ -269,6 +311,80 @@ static void apis(void) {
                       serverModeStr + "\"}");
   });
 
+  // 获取运动检测策略
+  server.on("/motion", HTTP_GET, [](AsyncWebServerRequest *request) {
+    clientConnected = true;
+    motion::Policy policy = motion::getPolicy();
+    String json = "{\"moveThreshold\":" + String(policy.moveThreshold) +
+                  ",\"stillThreshold\":" + String(policy.stillThreshold) +
+                  ",\"stillMs\":" + String(policy.stillMs) +
+                  ",\"idleHz\":" + String(policy.idleHz) +
+                  ",\"stationary\":" + (motion::isStationary() ? "1" : "0") +
+                  "}";
+    request->send(200, "text/json", json);
+  });
+
+  // 设置运动检测策略, 没有提供的参数保持不变
+  server.on("/motion", HTTP_POST, [](AsyncWebServerRequest *request) {
+    clientConnected = true;
+    motion::Policy policy = motion::getPolicy();
+    if (request->hasParam("moveThreshold")) {
+      policy.moveThreshold = request->getParam("moveThreshold")->value().toInt();
+    }
+    if (request->hasParam("stillThreshold")) {
+      policy.stillThreshold =
+          request->getParam("stillThreshold")->value().toInt();
+    }
+    if (request->hasParam("stillMs")) {
+      policy.stillMs = request->getParam("stillMs")->value().toInt();
+    }
+    if (request->hasParam("idleHz")) {
+      long idleHz = request->getParam("idleHz")->value().toInt();
+      policy.idleHz = idleHz > 0 && idleHz <= 255 ? idleHz : 0;
+    }
+    if (policy.stillThreshold >= policy.moveThreshold || policy.stillMs == 0 ||
+        policy.idleHz == 0 || policy.idleHz > DEFAULT_RENDER_FPS) {
+      request->send(400, "text/plain",
+                    "stillThreshold must be below moveThreshold, stillMs > 0, "
+                    "idleHz between 1 and " +
+                        String(DEFAULT_RENDER_FPS));
+      return;
+    }
+    motion::setPolicy(policy);
+    preference::setMotionPolicy(policy);
+    request->send(200);
+  });
+
+  // 获取指针弹簧参数
+  server.on("/spring", HTTP_GET, [](AsyncWebServerRequest *request) {
+    clientConnected = true;
+    spring::Params params = spring::getParams();
+    request->send(200, "text/json",
+                  "{\"stiffness\":" + String(params.stiffness, 2) +
+                      ",\"damping\":" + String(params.damping, 2) + "}");
+  });
+
+  // 设置指针弹簧参数, 没有提供的参数保持不变
+  server.on("/spring", HTTP_POST, [](AsyncWebServerRequest *request) {
+    clientConnected = true;
+    spring::Params params = spring::getParams();
+    if (request->hasParam("stiffness")) {
+      params.stiffness = request->getParam("stiffness")->value().toFloat();
+    }
+    if (request->hasParam("damping")) {
+      params.damping = request->getParam("damping")->value().toFloat();
+    }
+    if (!(params.stiffness >= SPRING_STIFFNESS_MIN &&
+          params.stiffness <= SPRING_STIFFNESS_MAX) ||
+        !(params.damping > 0 && params.damping <= SPRING_DAMPING_MAX)) {
+      request->send(400, "text/plain", "stiffness or damping out of range");
+      return;
+    }
+    spring::setParams(params);
+    preference::setSpringParams(params);
+    request->send(200);
+  });
+
   //////////////////////////// 旧API ////////////////////////////
   // 兼容性保留setWiFi
   server.on("/setWiFi", HTTP_POST, [](AsyncWebServerRequest *request) {
@@ -295,7 +411,8 @@ static void apis(void) {
       }
       ESP_LOGI(TAG, "setColor to %06X\n", hexRgb);
       ctx->setSubscribeSource(Event::Source::WEB_SERVER);
-      pixel::showSolid(hexRgb);
+      // LED只由渲染任务输出
+      render::showSolid(hexRgb);
       request->send(200);
     }
   });
@@ -320,8 +437,7 @@ static void apis(void) {
         }
       }
       ctx->setSubscribeSource(Event::Source::WEB_SERVER);
-      pixel::setPointerColor(hexRgb);
-      pixel::showFrame(index);
+      render::showFrame(index, hexRgb);
       request->send(200, "text/plain", "OK");
     } else {
       request->send(400, "text/plain", "Missing index parameter");
@@ -1,7 +1,6 @@
 #include <FastLED.h>
 #include <NimBLEDevice.h>
 #include <Preferences.h>
-#include <QMC5883LCompass.h>
 #include <esp_log.h>
 #include <esp_task_wdt.h>
 
@@ -10,27 +9,23 @@
 #include "event.h"
 using namespace mcompass;
 
-ESP_EVENT_DEFINE_BASE(MCOMPASS_EVENT);
-
 static const char *TAG = "MAIN";
 esp_event_loop_handle_t eventLoop;
 
 void dispatcher(void *handler_arg, esp_event_base_t base, int32_t id,
                 void *event_data) {
   Event::Body *evt = (Event::Body *)event_data;
-  Context &context = Context::getInstance();
-
-  if (context.getCurrentState()) {
-    context.getCurrentState()->handleEvent(context, evt);
-  }
+  Context::getInstance().handleEvent(evt);
 }
 
 void setup() {
   // 延时,用于一些特殊情况下能够重新烧录
   delay(1000);
   Context &context = Context::getInstance();
+  // 只承载控制事件(按钮, 文字, 校准, 恢复出厂等), 最高优先级.
+  // 方位角等流式数据经 mailbox 覆盖最新值, 不进入队列
   esp_event_loop_args_t loop_args = {
-      .queue_size = 128,
+      .queue_size = CONTROL_EVENT_QUEUE_SIZE,
       .task_name = "event_loop",
       .task_priority = configMAX_PRIORITIES - 1,
       .task_stack_size = 1024 * 16,
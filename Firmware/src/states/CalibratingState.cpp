@@ -1,51 +1,66 @@
 #include "states/CalibratingState.h" // 用于状态切换
+#include "calibrator_def.h"
 #include "context.h"
-#include "pixel_def.h"
+#include "render_def.h"
 #include "sensor_def.h"
 
 using namespace mcompass;
 
+static void postDone(Context *context, Event::Source source) {
+  Event::Body event;
+  event.type = Event::Type::CALIBRATION_DONE;
+  event.source = source;
+  context->postEvent(event);
+}
+
+// 进入即开始校准, 不在事件循环中等待: 传感器定时器把采样送入在线校准,
+// 结果合格时由传感器发出 CALIBRATION_DONE; 倒计时和进度动画由渲染任务绘制
 void CalibratingState::onEnter(Context &context) {
+  ESP_LOGI(getName(), "deviceState=%d", context.getDeviceState());
+  m_enterTime = millis();
+  if (!sensor::available()) {
+    ESP_LOGW(getName(), "No sensor, skip calibration");
+    postDone(&context, Event::Source::OTHER);
+    return;
+  }
+  calibrator::begin();
+  context.setDeviceState(State::CALIBRATE);
+  render::setEnabled(true);
 
+  if (m_timeout == nullptr) {
+    esp_timer_create_args_t timer_args = {
+        .callback =
+            [](void *arg) {
+              ESP_LOGW("CALIBRATING", "Calibrate timeout");
+              postDone(static_cast<Context *>(arg), Event::Source::OTHER);
+            },
+        .arg = &context,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "calibrate_timeout",
+        .skip_unhandled_events = true};
+    esp_timer_create(&timer_args, &m_timeout);
+  }
+  esp_timer_start_once(m_timeout, (uint64_t)CALIBRATE_TIMEOUT_MS * 1000);
 };
 void CalibratingState::onExit(Context &context) {
-
+  if (m_timeout != nullptr) {
+    esp_timer_stop(m_timeout);
+  }
+  render::setEnabled(false);
+  context.setDeviceState(State::COMPASS);
+  // 取消或超时时保留之前的校准数据
+  calibrator::end();
+  calibrator::Result result;
+  if (calibrator::last(result)) {
+    ESP_LOGI(getName(), "Exit after %ums, quality=%.2f coverage=%.2f",
+             (unsigned)(millis() - m_enterTime), result.quality,
+             result.coverage);
+  } else {
+    ESP_LOGI(getName(), "Exit after %ums without result",
+             (unsigned)(millis() - m_enterTime));
+  }
 };
+// 结束和取消由 StateTable 的转换表处理, 其他事件在校准中忽略
 void CalibratingState::handleEvent(Context &context, Event::Body *evt) {
-  auto deviceState = context.getDeviceState();
-  ESP_LOGI(getName(), "deviceState=%d", deviceState);
-  context.setDeviceState(State::INFO);
-  // 倒计时3秒
-  pixel::counterDown(3);
-  String text = String("Claibrate");
-
-  xTaskCreate(
-      [](void *ctx) {
-        auto context = static_cast<Context *>(ctx);
-        ESP_LOGI("", "Calibrate Start");
-        sensor::calibrate();
-        context->setDeviceState(State::COMPASS);
-        ESP_LOGI("", "Calibrate Done.");
-        vTaskDelete(NULL);
-      },
-      "calibrate", 8192, &context, configMAX_PRIORITIES - 1, NULL);
 
-  int x = 0;
-  size_t length = text.length();
-  int xLimit = -length * 4;
-  while (context.getDeviceState() == State::INFO) {
-    pixel::clear();
-    for (size_t i = 0; i < length; i++) {
-      pixel::drawChar(text.charAt(i), x + i * 4, 0, 0x00ff00);
-    }
-    pixel::show();
-    delay(100);
-    x--;
-    if (x < xLimit) {
-      x = 10;
-    }
-  }
-  ESP_LOGI(getName(), "Exit Info State");
-
-  esp_restart();
-};
\ No newline at end of file
+};
@@ -4,13 +4,8 @@
 #include "preference_def.h"
 
 using namespace mcompass;
+// 进入即开始恢复出厂设置, 不等待下一个事件
 void FactoryResetState::onEnter(Context &context) {
-
-};
-void FactoryResetState::onExit(Context &context) {
-
-};
-void FactoryResetState::handleEvent(Context &context, Event::Body *evt) {
   auto deviceState = context.getDeviceState();
   context.setDeviceState(State::INFO);
   ESP_LOGW(getName(), "Factory Reset!!!");
@@ -20,4 +15,10 @@ void FactoryResetState::handleEvent(Context &context, Event::Body *evt) {
   preference::factoryReset();
   // 重启
   esp_restart();
-};
\ No newline at end of file
+};
+void FactoryResetState::onExit(Context &context) {
+
+};
+void FactoryResetState::handleEvent(Context &context, Event::Body *evt) {
+
+};
@@ -0,0 +1,51 @@
+#include "states/StateTable.h"
+#include "states/CalibratingState.h"
+#include "states/CompassState.h"
+#include "states/FactoryResetState.h"
+
+using namespace mcompass;
+
+// 所有状态都是静态实例, 切换状态不再 new/delete
+static CompassState compassState;
+static CalibratingState calibratingState;
+static FactoryResetState factoryResetState;
+
+static IState *const instances[] = {&compassState, &calibratingState,
+                                    &factoryResetState};
+static_assert(sizeof(instances) / sizeof(instances[0]) ==
+                  static_cast<size_t>(StateId::COUNT),
+              "instances out of sync with StateId");
+
+struct Transition {
+  StateId from;
+  Event::Type type;
+  StateId to;
+};
+
+// 状态转换表: 当前状态收到指定事件时切换到目标状态
+static constexpr Transition transitions[] = {
+    {StateId::COMPASS, Event::Type::SENSOR_CALIBRATE, StateId::CALIBRATING},
+    {StateId::COMPASS, Event::Type::FACTORY_RESET, StateId::FACTORY_RESET},
+    {StateId::CALIBRATING, Event::Type::CALIBRATION_DONE, StateId::COMPASS},
+    // 校准中单击取消, 保留之前的校准数据
+    {StateId::CALIBRATING, Event::Type::BUTTON_CLICK, StateId::COMPASS},
+};
+
+IState *states::get(StateId id) {
+  return id < StateId::COUNT ? instances[static_cast<size_t>(id)] : nullptr;
+}
+
+const char *states::name(StateId id) {
+  IState *state = get(id);
+  return state != nullptr ? state->getName() : "NONE";
+}
+
+bool states::findTransition(StateId from, Event::Type type, StateId &to) {
+  for (const Transition &transition : transitions) {
+    if (transition.from == from && transition.type == type) {
+      to = transition.to;
+      return true;
+    }
+  }
+  return false;
+}